@@ -54,6 +54,7 @@ bool GL::loadOBJ(
 			int matches = fscanf_s(file, "%d/%d/%d %d/%d/%d %d/%d/%d\n", &vertexIndex[0], &uvIndex[0], &normalIndex[0], &vertexIndex[1], &uvIndex[1], &normalIndex[1], &vertexIndex[2], &uvIndex[2], &normalIndex[2]);
 			if (matches != 9) {
 				printf("File can't be read by our simple parser :-( Try exporting with other options\n");
+				fclose(file);
 				return false;
 			}
 			vertexIndices.push_back(vertexIndex[0]);
@@ -73,6 +74,13 @@ bool GL::loadOBJ(
 		}
 
 	}
+	fclose(file);
+
+	// The output size is known once all faces are read, so allocate it once
+	// instead of letting push_back grow (and copy) the buffers repeatedly.
+	out_vertices.reserve(out_vertices.size() + vertexIndices.size());
+	out_uvs.reserve(out_uvs.size() + vertexIndices.size());
+	out_normals.reserve(out_normals.size() + vertexIndices.size());
 
 	// For each vertex of each triangle
 	for (unsigned int i = 0; i<vertexIndices.size(); i++) {
@@ -391,6 +399,8 @@ GLuint GL::loadDDS(const char * imagepath) {
 	unsigned int mipMapCount = *(unsigned int*)&(header[24]);
 	unsigned int fourCC = *(unsigned int*)&(header[80]);
 
+	// A DDS without a mipmap chain may leave the count at 0 : it still holds the base level
+	if (mipMapCount == 0) mipMapCount = 1;
 
 	unsigned char * buffer;
 	unsigned int bufsize;
@@ -431,7 +441,8 @@ GLuint GL::loadDDS(const char * imagepath) {
 	unsigned int offset = 0;
 
 	/* load the mipmaps */
-	for (unsigned int level = 0; level < mipMapCount && (width || height); ++level)
+	unsigned int level = 0;
+	for (; level < mipMapCount && (width || height); ++level)
 	{
 		unsigned int size = ((width + 3) / 4)*((height + 3) / 4)*blockSize;
 		glCompressedTexImage2D(GL_TEXTURE_2D, level, format, width, height,
@@ -447,6 +458,11 @@ GLuint GL::loadDDS(const char * imagepath) {
 
 	}
 
+	// Only sample the levels we actually have, otherwise a partial chain
+	// makes the texture incomplete with the default mipmapped min filter.
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
+
 	free(buffer);
 
 	return textureID;
@@ -456,8 +472,11 @@ GLuint GL::loadDDS(const char * imagepath) {
 
 
 // Returns true iif v1 can be considered equal to v2
+// Tolerance under which two vertex attributes are considered the same
+static const float NEAR_TOLERANCE = 0.01f;
+
 bool is_near(float v1, float v2) {
-	return fabs(v1 - v2) < 0.01f;
+	return fabs(v1 - v2) < NEAR_TOLERANCE;
 }
 
 // Searches through all already-exported vertices
@@ -493,6 +512,75 @@ bool GL::getSimilarVertexIndex(
 	return false;
 }
 
+// Buckets already-exported vertices by position so that a lookup only has
+// to test the vertices of the neighbouring cells instead of all of them.
+// The cell is twice as wide as the is_near tolerance, so two positions that
+// are near each other always fall in the same or in adjacent cells.
+class SimilarVertexGrid {
+public:
+	typedef std::tuple<long long, long long, long long> Cell;
+
+	static Cell cellOf(glm::vec3 const & v) {
+		double const size = 2.0 * NEAR_TOLERANCE;
+		return Cell(
+			static_cast<long long>(std::floor(v.x / size)),
+			static_cast<long long>(std::floor(v.y / size)),
+			static_cast<long long>(std::floor(v.z / size))
+		);
+	}
+
+	// Same result as GL::getSimilarVertexIndex : the lowest matching index
+	bool find(
+		glm::vec3 const & in_vertex,
+		glm::vec2 const & in_uv,
+		glm::vec3 const & in_normal,
+		std::vector<glm::vec3> const & out_vertices,
+		std::vector<glm::vec2> const & out_uvs,
+		std::vector<glm::vec3> const & out_normals,
+		unsigned short & result
+	) const {
+		// is_near never holds for NaN, and infinities have no cell
+		if (!std::isfinite(in_vertex.x) || !std::isfinite(in_vertex.y) || !std::isfinite(in_vertex.z))
+			return false;
+		Cell const c = cellOf(in_vertex);
+		bool found = false;
+		for (long long dx = -1; dx <= 1; dx++)
+		for (long long dy = -1; dy <= 1; dy++)
+		for (long long dz = -1; dz <= 1; dz++) {
+			auto it = cells.find(Cell(std::get<0>(c) + dx, std::get<1>(c) + dy, std::get<2>(c) + dz));
+			if (it == cells.end()) continue;
+			// Indices in a cell are stored in increasing order
+			for (unsigned short i : it->second) {
+				if (found && i >= result) break;
+				if (
+					is_near(in_vertex.x, out_vertices[i].x) &&
+					is_near(in_vertex.y, out_vertices[i].y) &&
+					is_near(in_vertex.z, out_vertices[i].z) &&
+					is_near(in_uv.x, out_uvs[i].x) &&
+					is_near(in_uv.y, out_uvs[i].y) &&
+					is_near(in_normal.x, out_normals[i].x) &&
+					is_near(in_normal.y, out_normals[i].y) &&
+					is_near(in_normal.z, out_normals[i].z)
+					) {
+					result = i;
+					found = true;
+					break;
+				}
+			}
+		}
+		return found;
+	}
+
+	void add(glm::vec3 const & vertex, unsigned short index) {
+		if (!std::isfinite(vertex.x) || !std::isfinite(vertex.y) || !std::isfinite(vertex.z))
+			return;
+		cells[cellOf(vertex)].push_back(index);
+	}
+
+private:
+	std::map<Cell, std::vector<unsigned short>> cells;
+};
+
 void indexVBO_slow(
 	std::vector<glm::vec3> & in_vertices,
 	std::vector<glm::vec2> & in_uvs,
@@ -534,14 +622,18 @@ void GL::indexVBO(
 ) {
 	std::map<PackedVertex, unsigned short> VertexToOutIndex;
 
+	// On a miss, hint is left where packed would be inserted, so adding it
+	// afterwards doesn't have to walk the tree a second time.
 	auto getSimilarVertexIndex_fast = [](
 		GL::PackedVertex & packed,
 		std::map<GL::PackedVertex, unsigned short> & VertexToOutIndex,
+		std::map<GL::PackedVertex, unsigned short>::iterator & hint,
 		unsigned short & result
 	)
 	{
-		std::map<GL::PackedVertex, unsigned short>::iterator it = VertexToOutIndex.find(packed);
-		if (it == VertexToOutIndex.end()) {
+		std::map<GL::PackedVertex, unsigned short>::iterator it = VertexToOutIndex.lower_bound(packed);
+		hint = it;
+		if (it == VertexToOutIndex.end() || packed < it->first) {
 			return false;
 		}
 		else {
@@ -558,7 +650,8 @@ void GL::indexVBO(
 
 		// Try to find a similar vertex in out_XXXX
 		unsigned short index;
-		bool found = getSimilarVertexIndex_fast(packed, VertexToOutIndex, index);
+		std::map<PackedVertex, unsigned short>::iterator hint;
+		bool found = getSimilarVertexIndex_fast(packed, VertexToOutIndex, hint, index);
 
 		if (found) { // A similar vertex is already in the VBO, use it instead !
 			out_indices.push_back(index);
@@ -569,7 +662,7 @@ void GL::indexVBO(
 			out_normals.push_back(in_normals[i]);
 			unsigned short newindex = (unsigned short)out_vertices.size() - 1;
 			out_indices.push_back(newindex);
-			VertexToOutIndex[packed] = newindex;
+			VertexToOutIndex.emplace_hint(hint, packed, newindex);
 		}
 	}
 }
@@ -594,12 +687,14 @@ void GL::indexVBO_TBN(
 	std::vector<glm::vec3> & out_tangents,
 	std::vector<glm::vec3> & out_bitangents
 ) {
+	SimilarVertexGrid grid;
+
 	// For each input vertex
 	for (unsigned int i = 0; i<in_vertices.size(); i++) {
 
 		// Try to find a similar vertex in out_XXXX
 		unsigned short index;
-		bool found = GL::getSimilarVertexIndex(in_vertices[i], in_uvs[i], in_normals[i], out_vertices, out_uvs, out_normals, index);
+		bool found = grid.find(in_vertices[i], in_uvs[i], in_normals[i], out_vertices, out_uvs, out_normals, index);
 
 		if (found) { // A similar vertex is already in the VBO, use it instead !
 			out_indices.push_back(index);
@@ -615,6 +710,7 @@ void GL::indexVBO_TBN(
 			out_tangents.push_back(in_tangents[i]);
 			out_bitangents.push_back(in_bitangents[i]);
 			out_indices.push_back((unsigned short)out_vertices.size() - 1);
+			grid.add(in_vertices[i], out_indices.back());
 		}
 	}
 }
@@ -664,18 +760,20 @@ void GL::load_ply( std::string const &filename, std::vector< float > &point, std
     {
     case format::ASCII:
     {
+        // 1sgetlineœǂ݁AsƂistringstream炸strtof/strtoulŒډ͂
+        // s̎c( x y zȊÕvpeB )͖AȂl0ɂȂ
         for( int i = 0; i < vertexline && std::getline( ifs, line ); ++i )
         {
-            std::istringstream iss( line );
             auto const ind = i * 3;
-            iss >> point[ ind + 0 ] >> point[ ind + 1 ] >> point[ ind + 2 ];
+            char *p = &line[ 0 ];
+            for( int j = 0; j < 3; ++j ) point[ ind + j ] = std::strtof( p, &p );
         }
         for( int i = 0; i < faceline && std::getline( ifs, line ); ++i )
         {
-            std::istringstream iss( line );
             auto const ind = i * 3;
-            int dummy;
-            iss >> dummy >> index[ ind + 0 ] >> index[ ind + 1 ] >> index[ ind + 2 ];
+            char *p = &line[ 0 ];
+            auto const dummy = std::strtol( p, &p, 10 );
+            for( int j = 0; j < 3; ++j ) index[ ind + j ] = static_cast< unsigned int >( std::strtoul( p, &p, 10 ) );
             if( dummy != 3 )
             {
                 point.clear();
@@ -687,23 +785,23 @@ void GL::load_ply( std::string const &filename, std::vector< float > &point, std
     break;
     case format::BINARY_LE:
     {
-        for( int i = 0; i < vertexline; ++i )
-        {
-            auto const ind = i * 3;
-            for( int j = 0; j < 3; ++j ) ifs.read( reinterpret_cast< char * >( &point[ ind + j ] ), sizeof( float ) );
-        }
+        // _float x 3l܂ĕł̂ŁÂ܂pointֈꊇœǂݍ
+        ifs.read( reinterpret_cast< char * >( point.data() ), std::size( point ) * sizeof( float ) );
+        // ʂ( uchar, uint x 3 )13oCgȂ̂ŁA܂Ƃ߂ēǂłWJ
+        std::size_t const face_bytes = sizeof( char ) + 3 * sizeof( unsigned int );
+        std::vector< char > face_buff( faceline * face_bytes );
+        ifs.read( face_buff.data(), std::size( face_buff ) );
         for( int i = 0; i < faceline; ++i )
         {
             auto const ind = i * 3;
-            char dummy;
-            ifs.read( &dummy, sizeof( char ) );
-            if( dummy != 3 )
+            auto const *p = &face_buff[ i * face_bytes ];
+            if( p[ 0 ] != 3 )
             {
                 point.clear();
                 index.clear();
                 return;
             }
-            for( int j = 0; j < 3; ++j ) ifs.read( reinterpret_cast< char * >( &index[ ind + j ] ), sizeof( float ) );
+            std::memcpy( &index[ ind ], p + 1, 3 * sizeof( unsigned int ) );
         }
     }
     break;
@@ -795,8 +893,34 @@ std::tuple< std::tuple< float, float >, std::tuple< float, float >, std::tuple<
     return std::make_tuple( x, y, z );
 }
 
+// glm::vec3̔zfloat̔zփRs[ɁAx, y, z̍ŏő1pXŋ߂
+void GL::minmax_coord( std::vector< glm::vec3 > const &point, std::tuple< float, float > &x_minmax, std::tuple< float, float > &y_minmax, std::tuple< float, float > &z_minmax )
+{
+    glm::vec3 pmin( std::numeric_limits< float >::infinity() ), pmax( -std::numeric_limits< float >::infinity() );
+    for( auto const &p : point )
+    {
+        // glm::min/maxNaN`d̂ŁAfloat̔złƓrōXVNaNǂݔ΂
+        if( p.x < pmin.x ) pmin.x = p.x;
+        if( pmax.x < p.x ) pmax.x = p.x;
+        if( p.y < pmin.y ) pmin.y = p.y;
+        if( pmax.y < p.y ) pmax.y = p.y;
+        if( p.z < pmin.z ) pmin.z = p.z;
+        if( pmax.z < p.z ) pmax.z = p.z;
+    }
+    x_minmax = std::make_tuple( pmin.x, pmax.x );
+    y_minmax = std::make_tuple( pmin.y, pmax.y );
+    z_minmax = std::make_tuple( pmin.z, pmax.z );
+}
+
+std::tuple< std::tuple< float, float >, std::tuple< float, float >, std::tuple< float, float > > GL::minmax_coord( std::vector< glm::vec3 > const &point )
+{
+    std::tuple< float, float > x, y, z;
+    minmax_coord( point, x, y, z );
+    return std::make_tuple( x, y, z );
+}
+
 
-GLuint GL::TextureRGBImageUpLoad( const void *ImageData, const unsigned ImageWidth, const unsigned ImageHeight )
+GLuint GL::TextureRGBImageUpLoad( const void *ImageData, const unsigned ImageWidth, const unsigned ImageHeight, const GLenum ImageFormat )
 {
     GLuint texture_id;
     glGenTextures( 1, &texture_id );
@@ -809,7 +933,7 @@ GLuint GL::TextureRGBImageUpLoad( const void *ImageData, const unsigned ImageWid
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP );
-    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGB, ImageWidth, ImageHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, ImageData );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGB, ImageWidth, ImageHeight, 0, ImageFormat, GL_UNSIGNED_BYTE, ImageData );
     assert( glGetError() == GL_NO_ERROR );
     return texture_id;
 }
@@ -5,6 +5,7 @@
 #include <string>
 #include <fstream>
 #include <cstdio>
+#include <cstdlib>
 #include <tuple>
 #include <stdexcept>
 #include <iterator>
@@ -32,7 +33,7 @@ namespace GL
 		glm::vec3 position;
 		glm::vec2 uv;
 		glm::vec3 normal;
-		bool operator<(const PackedVertex that) const {
+		bool operator<(const PackedVertex &that) const {
 			return memcmp((void*)this, (void*)&that, sizeof(PackedVertex))>0;
 		};
 	};
@@ -129,6 +130,8 @@ namespace GL
 
     void minmax_coord( std::vector< float > const &point, std::tuple< float, float > &x_minmax, std::tuple< float, float > &y_minmax, std::tuple< float, float > &z_minmax );
     std::tuple< std::tuple< float, float >, std::tuple< float, float >, std::tuple< float, float > > minmax_coord( std::vector< float > const &point );
+    void minmax_coord( std::vector< glm::vec3 > const &point, std::tuple< float, float > &x_minmax, std::tuple< float, float > &y_minmax, std::tuple< float, float > &z_minmax );
+    std::tuple< std::tuple< float, float >, std::tuple< float, float >, std::tuple< float, float > > minmax_coord( std::vector< glm::vec3 > const &point );
 
     template< typename T >
     static
@@ -149,5 +152,6 @@ namespace GL
         return Call{ pfunc };
     }
 
-    GLuint TextureRGBImageUpLoad( const void *ImageData, const unsigned ImageWidth, const unsigned ImageHeight );
+    // ImageFormatGL_BGRncv::MatȂǂ̉f̂܂ܓ]łAבւGLōs
+    GLuint TextureRGBImageUpLoad( const void *ImageData, const unsigned ImageWidth, const unsigned ImageHeight, const GLenum ImageFormat = GL_RGB );
 }
\ No newline at end of file
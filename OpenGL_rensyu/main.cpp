@@ -56,7 +56,11 @@ void window_key_callback( GLFWwindow *window, int key, int scancode, int action,
             {
                 auto const vs = GL::readallfile( "NormalMapping.vertexshader" );
                 auto const fs = GL::readallfile( "NormalMapping.fragmentshader" );
-                if( auto p = GL::compile_shader( vs.c_str(), fs.c_str() ) ) data->program = p;
+                if( auto p = GL::compile_shader( vs.c_str(), fs.c_str() ) )
+                {
+                    glDeleteProgram( data->program );
+                    data->program = p;
+                }
             }
             catch( ... )
             {}
@@ -100,24 +104,38 @@ int main()
     //VF[_RpC
     main_window_data.program = GL::compile_shader( GL::readallfile( "NormalMapping.vertexshader" ).c_str(), GL::readallfile( "NormalMapping.fragmentshader" ).c_str() );
 
-    // Get a handle for our "MVP" uniform
-    GLuint MatrixID = glGetUniformLocation(main_window_data.program, "MVP");
-    GLuint ViewMatrixID = glGetUniformLocation(main_window_data.program, "V");
-    GLuint ModelMatrixID = glGetUniformLocation(main_window_data.program, "M");
-    GLuint ModelView3x3MatrixID = glGetUniformLocation(main_window_data.program, "MV3x3");
-
     // Load the texture
     GLuint DiffuseTexture = GL::loadDDS("diffuse.DDS");
     //GLuint NormalTexture = GL::loadBMP_custom("normal.bmp");
     cv::Mat img = cv::imread( "normal2.bmp" );
-    GLuint NormalTexture = GL::TextureRGBImageUpLoad( img.data, img.cols, img.rows );
+    GLuint NormalTexture = GL::TextureRGBImageUpLoad( img.data, img.cols, img.rows, GL_BGR );
     GLuint SpecularTexture = GL::loadDDS("specular.DDS");
 
-    // Get a handle for our "myTextureSampler" uniform
-    GLuint DiffuseTextureID  = glGetUniformLocation(main_window_data.program, "DiffuseTextureSampler");
-    GLuint NormalTextureID  = glGetUniformLocation(main_window_data.program, "NormalTextureSampler");
-    GLuint SpecularTextureID  = glGetUniformLocation(main_window_data.program, "SpecularTextureSampler");
+    //uniform̏ꏊƃTṽeNX`jbg̓vOƂɌ܂̂ŁA
+    //t[ł͂ȂvOςƂ( RL[ł̍ēǍ )蒼
+    GLuint located_program = 0;
+    GLuint MatrixID, ViewMatrixID, ModelMatrixID, ModelViewMatrixID, ModelView3x3MatrixID, LightID, LightCameraID;
+    auto const locate_uniforms = [ & ]( GLuint const program )
+    {
+        glUseProgram( program );
+        // Get a handle for our "MVP" uniform
+        MatrixID = glGetUniformLocation(program, "MVP");
+        ViewMatrixID = glGetUniformLocation(program, "V");
+        ModelMatrixID = glGetUniformLocation(program, "M");
+        ModelViewMatrixID = glGetUniformLocation(program, "MV");
+        ModelView3x3MatrixID = glGetUniformLocation(program, "MV3x3");
+        LightID = glGetUniformLocation(program, "LightPosition_worldspace");
+        LightCameraID = glGetUniformLocation(program, "LightPosition_cameraspace");
 
+        // Set our "DiffuseTextureSampler" sampler to user Texture Unit 0
+        glUniform1i(glGetUniformLocation(program, "DiffuseTextureSampler"), 0);
+        // Set our "NormalTextureSampler" sampler to user Texture Unit 1
+        glUniform1i(glGetUniformLocation(program, "NormalTextureSampler"), 1);
+        // Set our "SpecularTextureSampler" sampler to user Texture Unit 2
+        glUniform1i(glGetUniformLocation(program, "SpecularTextureSampler"), 2);
+        located_program = program;
+    };
+    locate_uniforms( main_window_data.program );
 
     //.objt@C̃[h
     std::vector<glm::vec3> vertices;
@@ -153,34 +171,33 @@ int main()
     auto const bitangentbuffer = GL::make_gl_buffer( GL_ARRAY_BUFFER, GL_STATIC_DRAW, indexed_bitangents );
     auto const elementbuffer = GL::make_gl_buffer( GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW, indices );
 
+    //_̐ݒVAOɈxL^ĂA`惋[vłVAOoCh邾ɂ
+    glBindVertexArray( vao );
 
-    auto const glmvec3tofloat = []( std::vector< glm::vec3 > const &glm_vertices, std::vector< GLfloat > &float_vertices )
-    {
-        float_vertices.clear();
-        float_vertices.resize( glm_vertices.size() * 3 );
-        for( int i = 0; i < glm_vertices.size(); i++ )
-        {
-            float_vertices[ i * 3 ] = glm_vertices[ i ][ 0 ];
-            float_vertices[ i * 3 + 1 ] = glm_vertices[ i ][ 1 ];
-            float_vertices[ i * 3 + 2 ] = glm_vertices[ i ][ 2 ];
-        }
-    };
+    glEnableVertexAttribArray( 0 );
+    glBindBuffer( GL_ARRAY_BUFFER, vertexbuffer );
+    glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
 
-    auto const floattoglmvec3 = [](  std::vector< GLfloat > const &float_vertices, std::vector< glm::vec3 > &glm_vertices )
-    {
-        glm_vertices.clear();
-        glm_vertices.resize( float_vertices.size() / 3 );
-        for( int i = 0; i < glm_vertices.size(); i++ )
-        {
-            glm_vertices[ i ][ 0 ] = float_vertices[ i * 3 ];
-            glm_vertices[ i ][ 1 ] = float_vertices[ i * 3 + 1 ];
-            glm_vertices[ i ][ 2 ] = float_vertices[ i * 3 + 2 ];
-        }
-    };
+    glEnableVertexAttribArray( 1 );
+    glBindBuffer( GL_ARRAY_BUFFER, uvbuffer );
+    glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
+
+    glEnableVertexAttribArray( 2 );
+    glBindBuffer( GL_ARRAY_BUFFER, normalbuffer );
+    glVertexAttribPointer( 2, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
 
-    std::vector< GLfloat > point;
-    glmvec3tofloat( indexed_vertices, point );
-    auto const minmax_coord = GL::minmax_coord( point );
+    glEnableVertexAttribArray( 3 );
+    glBindBuffer( GL_ARRAY_BUFFER, tangentbuffer );
+    glVertexAttribPointer( 3, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
+
+    glEnableVertexAttribArray( 4 );
+    glBindBuffer( GL_ARRAY_BUFFER, uvbuffer );
+    glVertexAttribPointer( 4, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
+
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, elementbuffer );
+
+
+    auto const minmax_coord = GL::minmax_coord( indexed_vertices );
     auto const &xminmax = std::get< 0 >( minmax_coord ), &yminmax = std::get< 1 >( minmax_coord ), &zminmax = std::get< 2 >( minmax_coord );
     auto const &xmin = std::get< 0 >( xminmax ), &xmax = std::get< 1 >( xminmax );
     auto const &ymin = std::get< 0 >( yminmax ), &ymax = std::get< 1 >( yminmax );
@@ -202,77 +219,43 @@ int main()
     glfwSetMouseButtonCallback( main_window, window_mouse_button_callback );
     glfwSetKeyCallback( main_window, window_key_callback );
 
-    glUseProgram(main_window_data.program);
-    GLuint LightID = glGetUniformLocation(main_window_data.program, "LightPosition_worldspace");
-
     while( !glfwWindowShouldClose( main_window ) )
     {
         glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
         glm::mat4 const model = main_window_data.model * c_model;
-        glm::mat4 const mvp = main_window_data.proj * main_window_data.view * model;
+        glm::mat4 const mv = main_window_data.view * model;
+        glm::mat4 const mvp = main_window_data.proj * mv;
         glm::mat3 const Rmat( model );
 
+        if( main_window_data.program != located_program ) locate_uniforms( main_window_data.program );
         glUseProgram( main_window_data.program );
 
         glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &mvp[0][0]);
         glUniformMatrix4fv(ModelMatrixID, 1, GL_FALSE, &model[0][0]);
+        glUniformMatrix4fv(ModelViewMatrixID, 1, GL_FALSE, &mv[0][0]);
         glUniformMatrix4fv(ViewMatrixID, 1, GL_FALSE, &main_window_data.view[0][0]);
         glUniformMatrix3fv(ModelView3x3MatrixID, 1, GL_FALSE, &Rmat[0][0]);
         glm::vec3 lightPos = glm::vec3(0,0,4);
         glUniform3f(LightID, lightPos.x, lightPos.y, lightPos.z);
+        glm::vec3 const lightPos_cameraspace = glm::vec3( main_window_data.view * glm::vec4( lightPos, 1.0f ) );
+        glUniform3f(LightCameraID, lightPos_cameraspace.x, lightPos_cameraspace.y, lightPos_cameraspace.z);
 
         // Bind our diffuse texture in Texture Unit 0
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, DiffuseTexture);
-        // Set our "DiffuseTextureSampler" sampler to user Texture Unit 0
-        glUniform1i(DiffuseTextureID, 0);
 
         // Bind our normal texture in Texture Unit 1
         glActiveTexture(GL_TEXTURE1);
         glBindTexture(GL_TEXTURE_2D, NormalTexture);
-        // Set our "Normal	TextureSampler" sampler to user Texture Unit 0
-        glUniform1i(NormalTextureID, 1);
 
         // Bind our normal texture in Texture Unit 2
         glActiveTexture(GL_TEXTURE2);
         glBindTexture(GL_TEXTURE_2D, SpecularTexture);
-        // Set our "Normal	TextureSampler" sampler to user Texture Unit 0
-        glUniform1i(SpecularTextureID, 2);
-
-        glEnableClientState( GL_VERTEX_ARRAY );
-
-        glEnableVertexAttribArray( 0 );
-        glBindBuffer( GL_ARRAY_BUFFER, vertexbuffer );
-        glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
-
-        glEnableVertexAttribArray( 1 );
-        glBindBuffer( GL_ARRAY_BUFFER, uvbuffer );
-        glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
-
-        glEnableVertexAttribArray( 2 );
-        glBindBuffer( GL_ARRAY_BUFFER, normalbuffer );
-        glVertexAttribPointer( 2, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
-
-        glEnableVertexAttribArray( 3 );
-        glBindBuffer( GL_ARRAY_BUFFER, tangentbuffer );
-        glVertexAttribPointer( 3, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
-
-        glEnableVertexAttribArray( 4 );
-        glBindBuffer( GL_ARRAY_BUFFER, uvbuffer );
-        glVertexAttribPointer( 4, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast< void * >( 0 ) );
-
-        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, elementbuffer );
 
+        glBindVertexArray( vao );
         glDrawElements( GL_TRIANGLES, static_cast< GLsizei >( indices.size() ), GL_UNSIGNED_SHORT, reinterpret_cast< void * >( 0 ) );
 
-        glDisableVertexAttribArray(0);
-        glDisableVertexAttribArray(1);
-        glDisableVertexAttribArray(2);
-        glDisableVertexAttribArray(3);
-        glDisableVertexAttribArray(4);
-
-        glDisableClientState( GL_VERTEX_ARRAY );
         glfwSwapBuffers( main_window );
         glfwPollEvents();
     }
@@ -207,7 +207,19 @@ enum KmeansFlags {
         user-supplied labels instead of computing them from the initial centers. For the second and
         further attempts, use the random or semi-random centers. Use one of KMEANS_\*_CENTERS flag
         to specify the exact method.*/
-    KMEANS_USE_INITIAL_LABELS = 1
+    KMEANS_USE_INITIAL_LABELS = 1,
+    /** Use the scalable k-means|| center initialization by Bahmani et al. [Bahmani2012]: a few
+        oversampling passes over the data pick O(K) candidates per pass, and kmeans++ is then run
+        on the weighted candidates only. Much cheaper than KMEANS_PP_CENTERS for large N and K.*/
+    KMEANS_PARALLEL_CENTERS   = 4,
+    /** Skip the distance computations that the triangle inequality proves unnecessary, keeping a
+        lower bound on the distance to the second closest center for every sample (Hamerly, 2010).
+        The labels, centers and compactness are the same as without the flag.*/
+    KMEANS_USE_BOUNDS         = 8,
+    /** Update the centers from small random batches of samples instead of the whole data set
+        (Sculley, 2010). criteria.maxCount is the number of batches. The result is approximate.
+        Cannot be combined with KMEANS_USE_BOUNDS.*/
+    KMEANS_MINI_BATCH         = 16
 };
 
 //! type of line
@@ -809,6 +821,39 @@ in each dimension are stored there sequentially.
 CV_EXPORTS void minMaxIdx(InputArray src, double* minVal, double* maxVal = 0,
                           int* minIdx = 0, int* maxIdx = 0, InputArray mask = noArray());
 
+/** @brief Statistics of an array computed by cv::computeArrayStats.
+ */
+struct CV_EXPORTS ArrayStats
+{
+    ArrayStats();
+
+    int count;         //!< number of elements taken into account
+    Scalar sum;        //!< per-channel sum of the elements taken into account
+    Scalar mean;       //!< per-channel mean, as computed by cv::meanStdDev
+    Scalar stddev;     //!< per-channel standard deviation, as computed by cv::meanStdDev
+    double minVal;     //!< minimum over all channels, 0 if count is 0
+    double maxVal;     //!< maximum over all channels, 0 if count is 0
+    Point minLoc;      //!< first element holding minVal, (-1,-1) if count is 0
+    Point maxLoc;      //!< first element holding maxVal, (-1,-1) if count is 0
+    double normInf;    //!< NORM_INF norm over all channels
+    double normL1;     //!< NORM_L1 norm over all channels
+    double normL2;     //!< NORM_L2 norm over all channels
+};
+
+/** @brief Computes the sum, mean, standard deviation, extrema and norms of an array in a single pass.
+
+The function gives the same results as calling cv::sum, cv::meanStdDev, cv::minMaxLoc and cv::norm
+on the same array, up to rounding, but reads the array only once. Unlike minMaxLoc, it also accepts
+multi-channel arrays: the extrema are searched over all channels and their locations are those of
+the elements holding them. NaN values are skipped by the extrema. Large arrays are processed in
+parallel; the result does not depend on the number of threads.
+@param src input array that has from 1 to 4 channels and at most 2 dimensions.
+@param stats output statistics.
+@param mask optional operation mask of type CV_8UC1 and the same size as src.
+@sa sum, meanStdDev, minMaxLoc, norm
+*/
+CV_EXPORTS void computeArrayStats(InputArray src, ArrayStats& stats, InputArray mask = noArray());
+
 /** @overload
 @param a input single-channel array.
 @param minVal pointer to the returned minimum value; NULL is used if not required.
@@ -2278,7 +2323,12 @@ class CV_EXPORTS PCA
 public:
     enum Flags { DATA_AS_ROW = 0, //!< indicates that the input samples are stored as matrix rows
                  DATA_AS_COL = 1, //!< indicates that the input samples are stored as matrix columns
-                 USE_AVG     = 2  //!
+                 USE_AVG     = 2, //!
+                 /** compute only the leading `maxComponents` components with a randomized range
+                 finder and power iterations instead of forming and decomposing the full covariance
+                 matrix; requires `maxComponents > 0` and pays off when `maxComponents` is much
+                 smaller than the sample dimensionality */
+                 RANDOMIZED  = 4
                };
 
     /** @brief default constructor
@@ -2326,8 +2376,8 @@ public:
     columns.
     @param mean optional mean value; if the matrix is empty (noArray()),
     the mean is computed from the data.
-    @param flags operation flags; currently the parameter is only used to
-    specify the data layout. (Flags)
+    @param flags operation flags; the data layout (Flags) optionally combined
+    with PCA::RANDOMIZED.
     @param maxComponents maximum number of components that PCA should
     retain; by default, all the components are retained.
     */
@@ -2406,9 +2456,25 @@ public:
     void write(FileStorage& fs ) const;
     void read(const FileNode& fs);
 
+    /** @brief folds a batch of samples into the existing %PCA
+
+    The method updates @ref mean, @ref eigenvalues and @ref eigenvectors so that they describe
+    all the samples seen so far, without access to the earlier batches. The retained components
+    summarize the old data, so the result is exact as long as no components have been dropped
+    and approximate otherwise. An empty %PCA structure is initialized from the first batch.
+
+    @param data batch of samples stored as the matrix rows or as the matrix columns.
+    @param flags operation flags; only the data layout (PCA::DATA_AS_ROW or PCA::DATA_AS_COL) is
+    used, and it must match the layout of the existing model.
+    @param maxComponents maximum number of components to retain after the update; by default,
+    the current number of components is kept (or all of them for an empty %PCA).
+    */
+    PCA& update(InputArray data, int flags, int maxComponents = 0);
+
     Mat eigenvectors; //!< eigenvectors of the covariation matrix
     Mat eigenvalues; //!< eigenvalues of the covariation matrix
     Mat mean; //!< mean value subtracted before the projection and added after the back projection
+    int64 samples; //!< number of samples the model has been computed from; used by PCA::update
 };
 
 /** @example pca.cpp
@@ -2831,6 +2897,55 @@ private:
     int mti;
 };
 
+/** @brief Counter-based random number generator (Philox4x32-10)
+
+The generator output is a pure function of the key and of a 64-bit block counter: block n
+of the stream is the Philox4x32 bijection (J. Salmon et al., "Parallel Random Numbers: As Easy
+as 1, 2, 3", SC'11) applied to n, and gives 4 32-bit words. RNG_Philox::fill assigns the words
+to the array elements by their position, so it splits the array between threads and still
+produces bit-identical output for any number of threads. Normally distributed values are
+produced with the Box-Muller transform.
+ */
+class CV_EXPORTS RNG_Philox
+{
+public:
+    RNG_Philox();
+    RNG_Philox(uint64 key);
+    /** @brief sets the key and rewinds the stream to the first block */
+    void seed(uint64 key);
+
+    /** @brief returns the next 32-bit word of the stream */
+    unsigned next();
+
+    operator unsigned();
+    operator float();
+    operator double();
+
+    /** @brief returns uniformly distributed integer random number from [a,b) range */
+    int uniform(int a, int b);
+    /** @brief returns uniformly distributed floating-point random number from [a,b) range */
+    float uniform(float a, float b);
+    /** @brief returns uniformly distributed double-precision floating-point random number from [a,b) range */
+    double uniform(double a, double b);
+    /** @brief returns normally distributed random number with zero mean and the specified sigma */
+    double gaussian(double sigma);
+
+    /** @brief Fills arrays with random numbers.
+
+    The parameters have the same meaning as in RNG::fill, except that a channel-mixing matrix is
+    not supported for RNG::NORMAL. The array consumes a whole number of blocks starting from the
+    current counter, which is then advanced past them.
+     */
+    void fill(InputOutputArray mat, int distType, InputArray a, InputArray b, bool saturateRange = false);
+
+    uint64 key;
+    uint64 counter;
+
+private:
+    unsigned words[4];
+    int pos;
+};
+
 //! @} core_array
 
 //! @addtogroup core_cluster
@@ -1413,6 +1413,7 @@ CVAPI(void)  cvCalcCovarMatrix( const CvArr** vects, int count,
 #define CV_PCA_DATA_AS_ROW 0
 #define CV_PCA_DATA_AS_COL 1
 #define CV_PCA_USE_AVG 2
+#define CV_PCA_RANDOMIZED 4
 CVAPI(void)  cvCalcPCA( const CvArr* data, CvArr* mean,
                         CvArr* eigenvals, CvArr* eigenvects, int flags );
 
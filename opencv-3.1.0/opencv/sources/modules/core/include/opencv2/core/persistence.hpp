@@ -309,7 +309,11 @@ public:
         FORMAT_MASK = (7<<3), //!< mask for format flags
         FORMAT_AUTO = 0,      //!< flag, auto format
         FORMAT_XML  = (1<<3), //!< flag, XML format
-        FORMAT_YAML = (2<<3)  //!< flag, YAML format
+        FORMAT_YAML = (2<<3), //!< flag, YAML format
+        BINARY_SIDECAR = 64,  //!< flag, write the data of large matrices to a binary "<filename>.raw" file
+                              //!< and keep only a reference to it in the XML/YAML; on reading, such
+                              //!< matrices are backed directly by a memory mapping of that file
+        VERIFY_SIDECAR = 128  //!< flag, check the CRC-32 of every matrix read from the binary sidecar
     };
     enum
     {
@@ -646,6 +650,105 @@ public:
     size_t remaining;
 };
 
+/** @brief Pull-style reader of XML/YAML files written by FileStorage.
+
+FileStorage parses the whole file into a tree of nodes before anything can be read from it. The
+reader parses it on demand instead and reports its content as a stream of events: the start and
+the end of every mapping and sequence, and every scalar value. Subtrees that are not needed are
+skipped without being stored, and matrices are parsed straight into the destination Mat, so the
+memory used depends only on the length of the longest line and the nesting depth, not on the size
+of the file.
+@code
+    FileStorageReader reader("model.yml.gz");
+    Mat weights;
+    for( int e = reader.next(); e != FileStorageReader::END_OF_STREAM; e = reader.next() )
+    {
+        if( reader.depth() == 0 && reader.name() == "weights" )
+            reader.readMat(weights);
+        else if( e == FileStorageReader::START_MAP || e == FileStorageReader::START_SEQ )
+            reader.skip();
+    }
+@endcode
+The reader understands the subset of XML and YAML that FileStorage writes. YAML anchors, aliases,
+block scalars and multiple documents are not supported. Like FileStorage, the reader cannot tell
+an XML sequence with a single scalar from the scalar itself; an XML element without any content is
+reported as an empty sequence.
+ */
+class CV_EXPORTS FileStorageReader
+{
+public:
+    //! events reported by next()
+    enum Event
+    {
+        NONE          = 0, //!< nothing has been read yet
+        START_MAP     = 1, //!< the start of a mapping
+        START_SEQ     = 2, //!< the start of a sequence
+        END           = 3, //!< the end of the innermost open mapping or sequence
+        SCALAR        = 4, //!< a number or a string
+        END_OF_STREAM = 5  //!< the end of the file
+    };
+
+    FileStorageReader();
+    //! opens the file, see open()
+    explicit FileStorageReader(const String& filename);
+    ~FileStorageReader();
+
+    /** @brief Opens a file for reading.
+
+    The format is detected from the first line of the file. Files with the .gz extension are
+    decompressed on the fly.
+    @return false if the file could not be opened
+     */
+    bool open(const String& filename);
+    //! returns true if a file is open
+    bool isOpened() const;
+    //! closes the file
+    void release();
+
+    //! reads the next event and returns it; keeps returning END_OF_STREAM once the file is exhausted
+    int next();
+    //! returns the current event
+    int event() const;
+    /** @brief returns the nesting level of the current event.
+
+    The top-level nodes of the file are at level 0. START_MAP/START_SEQ and the matching END are
+    reported at the level of the collection itself, and its elements one level deeper.
+     */
+    int depth() const;
+    //! returns the name of the current node, or an empty string for the elements of a sequence
+    String name() const;
+    //! returns the type name of the current node ("opencv-matrix", for example) or an empty string
+    String typeName() const;
+    //! returns the text of the current scalar, with quotes and escape sequences removed
+    String str() const;
+    //! returns the current scalar as a number; throws if it is not one
+    double real() const;
+
+    /** @brief Skips the rest of the collection the reader is at.
+
+    If the current event is START_MAP or START_SEQ, reads up to and including the matching END.
+    Does nothing otherwise.
+     */
+    void skip();
+
+    /** @brief Reads the matrix the reader is at.
+
+    The current event must be the START_MAP of a node written from a Mat (of type "opencv-matrix"
+    or "opencv-nd-matrix"); the reader is left at its END. m is reallocated only if its size or
+    type differs from the stored one. The data of matrices kept in a binary sidecar (see
+    FileStorage::BINARY_SIDECAR) is read from the sidecar file and its checksum is verified.
+     */
+    void readMat(Mat& m);
+
+protected:
+    struct Impl;
+    Ptr<Impl> p;
+
+private:
+    FileStorageReader(const FileStorageReader&);
+    FileStorageReader& operator = (const FileStorageReader&);
+};
+
 //! @} core_xml
 
 /////////////////// XML & YAML I/O implementation //////////////////
@@ -1669,6 +1669,8 @@ typedef struct CvFileStorage CvFileStorage;
 #define CV_STORAGE_FORMAT_AUTO   0
 #define CV_STORAGE_FORMAT_XML    8
 #define CV_STORAGE_FORMAT_YAML  16
+#define CV_STORAGE_BINARY_SIDECAR 64
+#define CV_STORAGE_VERIFY_SIDECAR 128
 
 /** @brief List of attributes. :
 
@@ -0,0 +1,40 @@
+#include "perf_precomp.hpp"
+
+using namespace std;
+using namespace cv;
+using namespace perf;
+using std::tr1::make_tuple;
+using std::tr1::get;
+
+CV_ENUM(GemmTFlags, 0, GEMM_1_T, GEMM_2_T, GEMM_1_T|GEMM_2_T)
+
+typedef std::tr1::tuple<int, GemmTFlags, bool> Size_Flags_Optimized_t;
+typedef perf::TestBaseWithParam<Size_Flags_Optimized_t> Size_Flags_Optimized;
+
+// "optimized" = false runs the old GEMMSingleMul/GEMMBlockMul path, so the two rows of each
+// size compare the packed SIMD kernel against it. The achieved GFLOP/s is recorded as "gflops".
+PERF_TEST_P( Size_Flags_Optimized, gemm_32f,
+             testing::Combine( testing::Values( 64, 128, 256, 512, 1024 ),
+                               GemmTFlags::all(),
+                               testing::Bool() ) )
+{
+    int n = get<0>(GetParam());
+    int flags = get<1>(GetParam());
+    bool optimized = get<2>(GetParam());
+
+    Mat a(n, n, CV_32F), b(n, n, CV_32F), c(n, n, CV_32F), d(n, n, CV_32F);
+    declare.in(a, b, c, WARMUP_RNG).out(d);
+    declare.time(100);
+
+    bool useOptimized0 = useOptimized();
+    setUseOptimized(optimized);
+
+    TEST_CYCLE() gemm(a, b, 1.0, c, 0.5, d, flags);
+
+    setUseOptimized(useOptimized0);
+
+    performance_metrics& m = calcMetrics();
+    RecordProperty("gflops", format("%.2f", 2.*n*n*n*1e-9*m.frequency/m.median).c_str());
+
+    SANITY_CHECK_NOTHING();
+}
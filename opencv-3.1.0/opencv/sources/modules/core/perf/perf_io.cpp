@@ -0,0 +1,62 @@
+#include "perf_precomp.hpp"
+
+using namespace std;
+using namespace cv;
+using namespace perf;
+using std::tr1::make_tuple;
+using std::tr1::get;
+
+CV_ENUM(StorageFormat, FileStorage::FORMAT_XML, FileStorage::FORMAT_YAML)
+CV_ENUM(SidecarMode, 0, FileStorage::BINARY_SIDECAR)
+
+typedef std::tr1::tuple<StorageFormat, SidecarMode> Format_Sidecar_t;
+typedef perf::TestBaseWithParam<Format_Sidecar_t> Format_Sidecar;
+
+PERF_TEST_P( Format_Sidecar, FileStorage_Mat_roundtrip,
+             testing::Combine( StorageFormat::all(), SidecarMode::all() ) )
+{
+    const int format = get<0>(GetParam()), sidecar = get<1>(GetParam());
+    string file = cv::tempfile(format == FileStorage::FORMAT_XML ? ".xml" : ".yml");
+
+    Mat src(512, 512, CV_32F), dst;
+    declare.in(src, WARMUP_RNG).time(60);
+
+    TEST_CYCLE()
+    {
+        {
+            FileStorage fs(file, FileStorage::WRITE + format + sidecar);
+            fs << "m" << src;
+        }
+        FileStorage fs(file, FileStorage::READ);
+        fs["m"] >> dst;
+    }
+
+    remove(file.c_str());
+    remove((file + ".raw").c_str());
+    SANITY_CHECK_NOTHING();
+}
+
+typedef perf::TestBaseWithParam<StorageFormat> Format;
+
+PERF_TEST_P( Format, FileStorageReader_readMat, StorageFormat::all() )
+{
+    const int format = GetParam();
+    string file = cv::tempfile(format == FileStorage::FORMAT_XML ? ".xml" : ".yml");
+
+    Mat src(512, 512, CV_32F), dst;
+    declare.in(src, WARMUP_RNG).time(60);
+    {
+        FileStorage fs(file, FileStorage::WRITE + format);
+        fs << "m" << src;
+    }
+
+    TEST_CYCLE()
+    {
+        FileStorageReader reader(file);
+        reader.next();
+        reader.readMat(dst);
+    }
+
+    remove(file.c_str());
+    SANITY_CHECK_NOTHING();
+}
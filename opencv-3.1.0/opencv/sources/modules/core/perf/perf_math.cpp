@@ -69,3 +69,76 @@ PERF_TEST_P( MaxDim_MaxPoints, kmeans,
 
     SANITY_CHECK(sortedClusterPointsNumber);
 }
+
+CV_ENUM(KMeansFlags, KMEANS_PP_CENTERS, KMEANS_PARALLEL_CENTERS, KMEANS_PP_CENTERS|KMEANS_USE_BOUNDS,
+        KMEANS_PARALLEL_CENTERS|KMEANS_USE_BOUNDS, KMEANS_PARALLEL_CENTERS|KMEANS_MINI_BATCH)
+
+typedef std::tr1::tuple<int, KMeansFlags> K_KMeansFlags_t;
+typedef perf::TestBaseWithParam<K_KMeansFlags_t> K_KMeansFlags;
+
+PERF_TEST_P( K_KMeansFlags, kmeans_large,
+             testing::Combine( testing::Values( 64, 256 ), KMeansFlags::all() ) )
+{
+    const int N = 20000, dims = 32, nblobs = 500;
+    const int K = get<0>(GetParam());
+    const int flags = get<1>(GetParam());
+    RNG& rng = theRNG();
+
+    Mat blobs(nblobs, dims, CV_32F), noise(1, dims, CV_32F), data(N, dims, CV_32F);
+    rng.fill(blobs, RNG::UNIFORM, -10, 10);
+    for( int i = 0; i < N; i++ )
+    {
+        rng.fill(noise, RNG::NORMAL, 0, 1);
+        add(blobs.row(rng.uniform(0, nblobs)), noise, data.row(i));
+    }
+
+    Mat labels, centers;
+    declare.in(data).time(120);
+
+    TEST_CYCLE()
+    {
+        kmeans(data, K, labels, TermCriteria(TermCriteria::MAX_ITER+TermCriteria::EPS, 30, 0),
+               1, flags, centers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+CV_ENUM(PCAFlags, PCA::DATA_AS_ROW, PCA::RANDOMIZED)
+
+typedef std::tr1::tuple<int, PCAFlags> Dims_PCAFlags_t;
+typedef perf::TestBaseWithParam<Dims_PCAFlags_t> Dims_PCAFlags;
+
+PERF_TEST_P( Dims_PCAFlags, pca_top16,
+             testing::Combine( testing::Values( 128, 512 ), PCAFlags::all() ) )
+{
+    const int N = 20000, dims = get<0>(GetParam());
+    const int flags = get<1>(GetParam());
+
+    Mat data(N, dims, CV_32F);
+    declare.in(data, WARMUP_RNG).time(60);
+
+    PCA pca;
+    TEST_CYCLE() pca(data, noArray(), flags, 16);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef perf::TestBaseWithParam<int> PCADims;
+
+PERF_TEST_P( PCADims, pca_update_top16, testing::Values( 128, 512 ) )
+{
+    const int N = 20000, dims = GetParam(), batch = 2000;
+
+    Mat data(N, dims, CV_32F);
+    declare.in(data, WARMUP_RNG).time(60);
+
+    TEST_CYCLE()
+    {
+        PCA pca;
+        for( int i = 0; i < N; i += batch )
+            pca.update(data.rowRange(i, i + batch), PCA::DATA_AS_ROW, 16);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
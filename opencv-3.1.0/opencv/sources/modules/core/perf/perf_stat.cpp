@@ -102,3 +102,18 @@ PERF_TEST_P(Size_MatType, countNonZero, testing::Combine( testing::Values( TYPIC
 
     SANITY_CHECK(cnt);
 }
+
+PERF_TEST_P(Size_MatType, computeArrayStats, TYPICAL_MATS)
+{
+    Size sz = get<0>(GetParam());
+    int matType = get<1>(GetParam());
+
+    Mat src(sz, matType);
+    ArrayStats stats;
+
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() computeArrayStats(src, stats);
+
+    SANITY_CHECK_NOTHING();
+}
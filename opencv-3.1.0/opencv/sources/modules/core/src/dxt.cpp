@@ -465,6 +465,146 @@ template<> struct DFT_VecR4<float>
 
 #endif
 
+// Radix-2, radix-3 and radix-5 butterflies of one group (the twiddled inner loop over j).
+// The vector versions process two neighbouring butterflies at once and return the first j
+// left for the scalar loop.
+template<typename T> struct DFT_VecR2
+{
+    int operator()(Complex<T>*, int j, int, int, const Complex<T>*) const { return j; }
+};
+
+template<typename T> struct DFT_VecR3
+{
+    int operator()(Complex<T>*, int j, int, int, const Complex<T>*) const { return j; }
+};
+
+template<typename T> struct DFT_VecR5
+{
+    int operator()(Complex<T>*, int j, int, int, const Complex<T>*) const { return j; }
+};
+
+#if CV_SSE3
+
+// (x0*w0, x1*w1) for two packed complex numbers
+static inline __m128 DFT_mulComplex2(__m128 x, __m128 w)
+{
+    __m128 t0 = _mm_mul_ps(_mm_moveldup_ps(x), w);
+    __m128 t1 = _mm_mul_ps(_mm_movehdup_ps(x), _mm_shuffle_ps(w, w, _MM_SHUFFLE(2,3,0,1)));
+    return _mm_addsub_ps(t0, t1);
+}
+
+// (wave[dw], wave[dw + dw0])
+static inline __m128 DFT_loadTwiddle2(const Complex<float>* wave, int dw, int dw0)
+{
+    __m128 w = _mm_setzero_ps();
+    w = _mm_loadl_pi(w, (const __m64*)&wave[dw]);
+    return _mm_loadh_pi(w, (const __m64*)&wave[dw + dw0]);
+}
+
+template<> struct DFT_VecR2<float>
+{
+    int operator()(Complex<float>* v, int j, int nx, int dw0, const Complex<float>* wave) const
+    {
+        for( ; j < nx - 1; j += 2 )
+        {
+            __m128 x0 = _mm_loadu_ps((const float*)(v + j));
+            __m128 x1 = DFT_mulComplex2(_mm_loadu_ps((const float*)(v + j + nx)),
+                                        DFT_loadTwiddle2(wave, j*dw0, dw0));
+            _mm_storeu_ps((float*)(v + j), _mm_add_ps(x0, x1));
+            _mm_storeu_ps((float*)(v + j + nx), _mm_sub_ps(x0, x1));
+        }
+        return j;
+    }
+};
+
+template<> struct DFT_VecR3<float>
+{
+    int operator()(Complex<float>* v, int j, int nx, int dw0, const Complex<float>* wave) const
+    {
+        const float sin_120 = 0.86602540378443864676372317075294f;
+        __m128 v_sin_120 = _mm_setr_ps(sin_120, -sin_120, sin_120, -sin_120);
+        __m128 v_half = _mm_set1_ps(0.5f);
+
+        for( ; j < nx - 1; j += 2 )
+        {
+            int dw = j*dw0;
+            __m128 a = DFT_mulComplex2(_mm_loadu_ps((const float*)(v + j + nx)),
+                                       DFT_loadTwiddle2(wave, dw, dw0));
+            __m128 b = DFT_mulComplex2(_mm_loadu_ps((const float*)(v + j + nx*2)),
+                                       DFT_loadTwiddle2(wave, dw*2, dw0*2));
+            __m128 s = _mm_add_ps(a, b), d = _mm_sub_ps(a, b);
+            __m128 x0 = _mm_loadu_ps((const float*)(v + j));
+
+            // (sin_120*im(d), -sin_120*re(d))
+            d = _mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2,3,0,1)), v_sin_120);
+            _mm_storeu_ps((float*)(v + j), _mm_add_ps(x0, s));
+            x0 = _mm_sub_ps(x0, _mm_mul_ps(s, v_half));
+            _mm_storeu_ps((float*)(v + j + nx), _mm_add_ps(x0, d));
+            _mm_storeu_ps((float*)(v + j + nx*2), _mm_sub_ps(x0, d));
+        }
+        return j;
+    }
+};
+
+template<> struct DFT_VecR5<float>
+{
+    int operator()(Complex<float>* v, int j, int nx, int dw0, const Complex<float>* wave) const
+    {
+        const float fft5_2 = 0.559016994374947424102293417182819f;
+        const float fft5_3 = -0.951056516295153572116439333379382f;
+        const float fft5_4 = -1.538841768587626701285145288018455f;
+        const float fft5_5 = 0.363271264002680442947733378740309f;
+        __m128 v_fft5_2 = _mm_set1_ps(fft5_2);
+        __m128 v_fft5_3 = _mm_setr_ps(-fft5_3, fft5_3, -fft5_3, fft5_3);
+        __m128 v_fft5_4 = _mm_setr_ps(-fft5_4, fft5_4, -fft5_4, fft5_4);
+        __m128 v_fft5_5 = _mm_setr_ps(-fft5_5, fft5_5, -fft5_5, fft5_5);
+        __m128 v_quarter = _mm_set1_ps(0.25f);
+
+        for( ; j < nx - 1; j += 2 )
+        {
+            int dw = j*dw0;
+            Complex<float>* v0 = v + j;
+            Complex<float>* v1 = v0 + nx*2;
+            Complex<float>* v2 = v1 + nx*2;
+
+            __m128 a3 = DFT_mulComplex2(_mm_loadu_ps((const float*)(v0 + nx)),
+                                        DFT_loadTwiddle2(wave, dw, dw0));
+            __m128 a2 = DFT_mulComplex2(_mm_loadu_ps((const float*)v2),
+                                        DFT_loadTwiddle2(wave, dw*4, dw0*4));
+            __m128 a4 = DFT_mulComplex2(_mm_loadu_ps((const float*)(v1 + nx)),
+                                        DFT_loadTwiddle2(wave, dw*3, dw0*3));
+            __m128 a0 = DFT_mulComplex2(_mm_loadu_ps((const float*)v1),
+                                        DFT_loadTwiddle2(wave, dw*2, dw0*2));
+            __m128 s1 = _mm_add_ps(a3, a2), d3 = _mm_sub_ps(a3, a2);
+            __m128 s2 = _mm_add_ps(a4, a0), d4 = _mm_sub_ps(a4, a0);
+            __m128 s5 = _mm_add_ps(s1, s2);
+            __m128 x0 = _mm_loadu_ps((const float*)v0);
+
+            _mm_storeu_ps((float*)v0, _mm_add_ps(x0, s5));
+            x0 = _mm_sub_ps(x0, _mm_mul_ps(s5, v_quarter));
+            s1 = _mm_mul_ps(_mm_sub_ps(s1, s2), v_fft5_2);
+
+            // the odd part: swapped re/im multiplied by (-c, c)
+            __m128 u = _mm_add_ps(d3, d4);
+            u = _mm_mul_ps(_mm_shuffle_ps(u, u, _MM_SHUFFLE(2,3,0,1)), v_fft5_3);
+            d3 = _mm_mul_ps(_mm_shuffle_ps(d3, d3, _MM_SHUFFLE(2,3,0,1)), v_fft5_5);
+            d4 = _mm_mul_ps(_mm_shuffle_ps(d4, d4, _MM_SHUFFLE(2,3,0,1)), v_fft5_4);
+            s5 = _mm_add_ps(u, d3);
+            u = _mm_sub_ps(u, d4);
+
+            __m128 x1 = _mm_add_ps(x0, s1);
+            x0 = _mm_sub_ps(x0, s1);
+            _mm_storeu_ps((float*)(v0 + nx), _mm_add_ps(x1, u));
+            _mm_storeu_ps((float*)v2, _mm_sub_ps(x1, u));
+            _mm_storeu_ps((float*)v1, _mm_add_ps(x0, s5));
+            _mm_storeu_ps((float*)(v1 + nx), _mm_sub_ps(x0, s5));
+        }
+        return j;
+    }
+};
+
+#endif
+
 #ifdef USE_IPP_DFT
 static IppStatus ippsDFTFwd_CToC( const Complex<float>* src, Complex<float>* dst,
                              const void* spec, uchar* buf)
@@ -546,6 +686,10 @@ DFT( const Complex<T>* src, Complex<T>* dst, int n,
     Complex<T> t;
     T scale = (T)_scale;
     int tab_step;
+    bool haveSSE3 = checkHardwareSupport(CV_CPU_SSE3);
+    DFT_VecR2<T> vr2;
+    DFT_VecR3<T> vr3;
+    DFT_VecR5<T> vr5;
 
 #ifdef USE_IPP_DFT
     if( spec )
@@ -664,7 +808,7 @@ DFT( const Complex<T>* src, Complex<T>* dst, int n,
     // 1. power-2 transforms
     if( (factors[0] & 1) == 0 )
     {
-        if( factors[0] >= 4 && checkHardwareSupport(CV_CPU_SSE3))
+        if( factors[0] >= 4 && haveSSE3 )
         {
             DFT_VecR4<T> vr4;
             n = vr4(dst, factors[0], n0, dw0, wave);
@@ -746,7 +890,8 @@ DFT( const Complex<T>* src, Complex<T>* dst, int n,
                 v[0].re = r0; v[0].im = i0;
                 v[nx].re = r1; v[nx].im = i1;
 
-                for( j = 1, dw = dw0; j < nx; j++, dw += dw0 )
+                j = haveSSE3 ? vr2(dst + i, 1, nx, dw0, wave) : 1;
+                for( dw = j*dw0; j < nx; j++, dw += dw0 )
                 {
                     v = dst + i + j;
                     r1 = v[nx].re*wave[dw].re - v[nx].im*wave[dw].im;
@@ -786,7 +931,8 @@ DFT( const Complex<T>* src, Complex<T>* dst, int n,
                 v[nx].re = r0 + r2; v[nx].im = i0 + i2;
                 v[nx*2].re = r0 - r2; v[nx*2].im = i0 - i2;
 
-                for( j = 1, dw = dw0; j < nx; j++, dw += dw0 )
+                j = haveSSE3 ? vr3(dst + i, 1, nx, dw0, wave) : 1;
+                for( dw = j*dw0; j < nx; j++, dw += dw0 )
                 {
                     v = dst + i + j;
                     r0 = v[nx].re*wave[dw].re - v[nx].im*wave[dw].im;
@@ -809,7 +955,8 @@ DFT( const Complex<T>* src, Complex<T>* dst, int n,
             // radix-5
             for( i = 0; i < n0; i += n )
             {
-                for( j = 0, dw = 0; j < nx; j++, dw += dw0 )
+                j = haveSSE3 ? vr5(dst + i, 0, nx, dw0, wave) : 0;
+                for( dw = j*dw0; j < nx; j++, dw += dw0 )
                 {
                     Complex<T>* v0 = dst + i + j;
                     Complex<T>* v1 = v0 + nx*2;
@@ -972,6 +1119,63 @@ DFT( const Complex<T>* src, Complex<T>* dst, int n,
 }
 
 
+// Post-processing of the forward real transform: splits the half-length complex spectrum into
+// the spectrum of the real sequence. The vector version does four iterations of the scalar loop
+// at once, while the elements it touches from the front and from the back of dst do not overlap.
+template<typename T> struct RealDFT_VecPack
+{
+    int operator()(T*, int j, int, int, T&, const Complex<T>*&, T) const { return j; }
+};
+
+#if CV_SSE2
+
+template<> struct RealDFT_VecPack<float>
+{
+    int operator()(float* dst, int j, int n, int n2, float& t, const Complex<float>*& wave, float scale2) const
+    {
+        __m128 v_scale2 = _mm_set1_ps(scale2);
+
+        for( ; j + 8 <= n2; j += 8, wave += 4 )
+        {
+            __m128 f0 = _mm_loadu_ps(dst + j), f1 = _mm_loadu_ps(dst + j + 4);
+            __m128 b1 = _mm_loadu_ps(dst + n - j - 3), b0 = _mm_loadu_ps(dst + n - j - 7);
+            __m128 w0 = _mm_loadu_ps((const float*)wave), w1 = _mm_loadu_ps((const float*)(wave + 2));
+            float t_next = dst[n - j - 7];
+
+            // lane k handles the scalar iteration j + 2*k
+            __m128 x = _mm_shuffle_ps(f0, f1, _MM_SHUFFLE(2,0,2,0)); // dst[j]
+            __m128 y = _mm_shuffle_ps(f0, f1, _MM_SHUFFLE(3,1,3,1)); // dst[j+1]
+            __m128 z = _mm_shuffle_ps(b1, b0, _MM_SHUFFLE(1,3,1,3)); // dst[n-j]
+            __m128 tp = _mm_shuffle_ps(b1, b0, _MM_SHUFFLE(0,2,0,2)); // dst[n-j-1]
+            __m128 v_t = _mm_move_ss(_mm_shuffle_ps(tp, tp, _MM_SHUFFLE(2,1,0,0)), _mm_set_ss(t));
+            __m128 wr = _mm_shuffle_ps(w0, w1, _MM_SHUFFLE(2,0,2,0));
+            __m128 wi = _mm_shuffle_ps(w0, w1, _MM_SHUFFLE(3,1,3,1));
+
+            __m128 h2_re = _mm_mul_ps(v_scale2, _mm_add_ps(y, v_t));
+            __m128 h2_im = _mm_mul_ps(v_scale2, _mm_sub_ps(z, x));
+            __m128 h1_re = _mm_mul_ps(v_scale2, _mm_add_ps(x, z));
+            __m128 h1_im = _mm_mul_ps(v_scale2, _mm_sub_ps(y, v_t));
+
+            __m128 r = _mm_sub_ps(_mm_mul_ps(h2_re, wr), _mm_mul_ps(h2_im, wi));
+            h2_im = _mm_add_ps(_mm_mul_ps(h2_re, wi), _mm_mul_ps(h2_im, wr));
+
+            __m128 a = _mm_add_ps(h1_re, r), c = _mm_add_ps(h1_im, h2_im);
+            __m128 b = _mm_sub_ps(h1_re, r), d = _mm_sub_ps(h2_im, h1_im);
+
+            _mm_storeu_ps(dst + j - 1, _mm_unpacklo_ps(a, c));
+            _mm_storeu_ps(dst + j + 3, _mm_unpackhi_ps(a, c));
+            b1 = _mm_unpacklo_ps(b, d);
+            b0 = _mm_unpackhi_ps(b, d);
+            _mm_storeu_ps(dst + n - j - 3, _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(1,0,3,2)));
+            _mm_storeu_ps(dst + n - j - 7, _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(1,0,3,2)));
+            t = t_next;
+        }
+        return j;
+    }
+};
+
+#endif
+
 /* FFT of real vector
    output vector format:
      re(0), re(1), im(1), ... , re(n/2-1), im((n+1)/2-1) [, re((n+1)/2)] OR ...
@@ -1060,7 +1264,10 @@ RealDFT( const T* src, T* dst, int n, int nf, int* factors, const int* itab,
         t = dst[n-1];
         dst[n-1] = dst[1];
 
-        for( j = 2, wave++; j < n2; j += 2, wave++ )
+        j = 2, wave++;
+        if( USE_SSE2 )
+            j = RealDFT_VecPack<T>()(dst, j, n, n2, t, wave, scale2);
+        for( ; j < n2; j += 2, wave++ )
         {
             /* calc odd */
             h2_re = scale2*(dst[j+1] + t);
@@ -2426,6 +2633,210 @@ static bool ocl_dft_amdfft(InputArray _src, OutputArray _dst, int flags)
 
 namespace cv
 {
+
+static void DCTInit( int n, int elem_size, void* _wave, int inv );
+
+// Factorization, permutation table and twiddle factors for one transform length.
+// Building them costs about as much as a short transform, so they are kept in DFTPlanCache
+// and shared between repeated calls and between the threads of one call.
+// A plan is never modified after construction.
+struct DFTPlan
+{
+    DFTPlan( int _len, int _complex_elem_size, int _inv_itab, bool _dct ) : len(_len)
+    {
+        nf = DFTFactorize( len, factors );
+        itab.resize( len );
+        // the complex<double> storage is reinterpreted as complex<float> for CV_32F transforms
+        wave.resize( len );
+        DFTInit( len, nf, factors, &itab[0], _complex_elem_size, &wave[0], _inv_itab );
+        if( _dct )
+        {
+            dct_wave.resize( len/2 + 1 );
+            DCTInit( len, _complex_elem_size, &dct_wave[0], _inv_itab );
+        }
+    }
+
+    int len, nf;
+    int factors[34];
+    std::vector<int> itab;
+    std::vector<Complexd> wave, dct_wave;
+};
+
+class DFTPlanCache
+{
+public:
+    static DFTPlanCache& getInstance()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(DFTPlanCache, new DFTPlanCache())
+    }
+
+    Ptr<DFTPlan> getPlan( int len, int complex_elem_size, int inv_itab, bool dct )
+    {
+        // the tables of very long transforms are big and such transforms are rarely repeated
+        if( len > MAX_CACHED_LEN )
+            return makePtr<DFTPlan>(len, complex_elem_size, inv_itab, dct);
+
+        int64 key = ((int64)len << 8) | (complex_elem_size << 2) | (inv_itab != 0 ? 2 : 0) | (dct ? 1 : 0);
+        AutoLock lock(mutex);
+        std::map<int64, Ptr<DFTPlan> >::iterator f = planStorage.find(key);
+        if( f != planStorage.end() )
+            return f->second;
+
+        // plans still in use by other calls survive the flush through their Ptr
+        if( planStorage.size() >= MAX_CACHED_PLANS )
+            planStorage.clear();
+        Ptr<DFTPlan> newPlan = makePtr<DFTPlan>(len, complex_elem_size, inv_itab, dct);
+        planStorage[key] = newPlan;
+        return newPlan;
+    }
+
+protected:
+    enum { MAX_CACHED_LEN = 1 << 16, MAX_CACHED_PLANS = 64 };
+
+    DFTPlanCache() : planStorage() {}
+
+    Mutex mutex;
+    std::map<int64, Ptr<DFTPlan> > planStorage;
+};
+
+// Row-wise pass of cv::dft: every row is an independent 1D transform.
+class DFTRowsInvoker : public ParallelLoopBody
+{
+public:
+    DFTRowsInvoker( const Mat& _src, Mat& _dst, DFTFunc _dft_func, int _len, int _nf,
+                    const int* _factors, const int* _itab, const uchar* _wave, const void* _spec,
+                    size_t _buf_size, bool _use_buf, int _complex_elem_size, int _dptr_offset,
+                    int _dst_full_len, int _flags, double _scale ) :
+        src(_src), dst(_dst), dft_func(_dft_func), len(_len), nf(_nf), factors(_factors),
+        itab(_itab), wave(_wave), spec(_spec), buf_size(_buf_size), use_buf(_use_buf),
+        complex_elem_size(_complex_elem_size), dptr_offset(_dptr_offset),
+        dst_full_len(_dst_full_len), flags(_flags), scale(_scale)
+    {
+    }
+
+    void operator()( const Range& range ) const
+    {
+        // RealDFT and CCSIDFT temporarily modify factors[0], so every thread works on its own copy
+        int factors_[34];
+        memcpy( factors_, factors, sizeof(factors_) );
+        AutoBuffer<uchar> buf( buf_size + 32 );
+        uchar* ptr = alignPtr( (uchar*)buf, 16 );
+        uchar* tmp_buf = 0;
+
+        if( use_buf )
+        {
+            tmp_buf = ptr;
+            ptr += len*complex_elem_size;
+        }
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const uchar* sptr = src.ptr(i);
+            uchar* dptr0 = dst.ptr(i);
+            uchar* dptr = tmp_buf ? tmp_buf : dptr0;
+
+            dft_func( sptr, dptr, len, nf, factors_, itab, wave, len, spec, ptr, flags, scale );
+            if( dptr != dptr0 )
+                memcpy( dptr0, dptr + dptr_offset, dst_full_len );
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    DFTFunc dft_func;
+    int len, nf;
+    const int* factors;
+    const int* itab;
+    const uchar* wave;
+    const void* spec;
+    size_t buf_size;
+    bool use_buf;
+    int complex_elem_size, dptr_offset, dst_full_len, flags;
+    double scale;
+};
+
+// Column-wise pass of cv::dft: complex columns are transformed two at a time,
+// so that the data is gathered into the row buffers with one pass over the rows.
+class DFTColumnsInvoker : public ParallelLoopBody
+{
+public:
+    DFTColumnsInvoker( const uchar* _sptr0, size_t _src_step, uchar* _dptr0, size_t _dst_step,
+                       int _ncols, DFTFunc _dft_func, int _len, int _nf, const int* _factors,
+                       const int* _itab, const uchar* _wave, const void* _spec, size_t _buf_size,
+                       bool _use_buf, int _complex_elem_size, int _inv, double _scale ) :
+        sptr0(_sptr0), src_step(_src_step), dptr0(_dptr0), dst_step(_dst_step), ncols(_ncols),
+        dft_func(_dft_func), len(_len), nf(_nf), factors(_factors), itab(_itab), wave(_wave),
+        spec(_spec), buf_size(_buf_size), use_buf(_use_buf),
+        complex_elem_size(_complex_elem_size), inv(_inv), scale(_scale)
+    {
+    }
+
+    // range is in pairs of columns
+    void operator()( const Range& range ) const
+    {
+        int factors_[34];
+        memcpy( factors_, factors, sizeof(factors_) );
+        AutoBuffer<uchar> buf( buf_size + 32 );
+        uchar* ptr = alignPtr( (uchar*)buf, 16 );
+        uchar *buf0, *buf1, *dbuf0, *dbuf1;
+
+        buf0 = ptr;
+        ptr += len*complex_elem_size;
+        buf1 = ptr;
+        ptr += len*complex_elem_size;
+        dbuf0 = buf0, dbuf1 = buf1;
+
+        if( use_buf )
+        {
+            dbuf1 = ptr;
+            dbuf0 = buf1;
+            ptr += len*complex_elem_size;
+        }
+
+        for( int p = range.start; p < range.end; p++ )
+        {
+            int i = p*2;
+            const uchar* sptr = sptr0 + i*complex_elem_size;
+            uchar* dptr = dptr0 + i*complex_elem_size;
+
+            if( i+1 < ncols )
+            {
+                CopyFrom2Columns( sptr, src_step, buf0, buf1, len, complex_elem_size );
+                dft_func( buf1, dbuf1, len, nf, factors_, itab,
+                          wave, len, spec, ptr, inv, scale );
+            }
+            else
+                CopyColumn( sptr, src_step, buf0, complex_elem_size, len, complex_elem_size );
+
+            dft_func( buf0, dbuf0, len, nf, factors_, itab,
+                      wave, len, spec, ptr, inv, scale );
+
+            if( i+1 < ncols )
+                CopyTo2Columns( dbuf0, dbuf1, dptr, dst_step, len, complex_elem_size );
+            else
+                CopyColumn( dbuf0, complex_elem_size, dptr, dst_step, len, complex_elem_size );
+        }
+    }
+
+private:
+    const uchar* sptr0;
+    size_t src_step;
+    uchar* dptr0;
+    size_t dst_step;
+    int ncols;
+    DFTFunc dft_func;
+    int len, nf;
+    const int* factors;
+    const int* itab;
+    const uchar* wave;
+    const void* spec;
+    size_t buf_size;
+    bool use_buf;
+    int complex_elem_size, inv;
+    double scale;
+};
+
 static void complementComplexOutput(Mat& dst, int len, int dft_dims)
 {
     int i, n = dst.cols;
@@ -2489,7 +2900,7 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
     };
     AutoBuffer<uchar> buf;
     Mat src0 = _src0.getMat(), src = src0;
-    int prev_len = 0, stage = 0;
+    int stage = 0;
     bool inv = (flags & DFT_INVERSE) != 0;
     int nf = 0, real_transform = src.channels() == 1 || (inv && (flags & DFT_REAL_OUTPUT)!=0);
     int type = src.type(), depth = src.depth();
@@ -2583,12 +2994,14 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
     for(;;)
     {
         double scale = 1;
-        uchar* wave = 0;
-        int* itab = 0;
+        const uchar* wave = 0;
+        const int* itab = 0;
         uchar* ptr;
-        int i, len, count, sz = 0;
+        int i, len, count;
+        size_t sz = 0;
         int use_buf = 0, odd_real = 0;
         DFTFunc dft_func;
+        Ptr<DFTPlan> plan;
 
         if( stage == 0 ) // row-wise transform
         {
@@ -2657,11 +3070,15 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
         else
 #endif
         {
-            if( len != prev_len )
-                nf = DFTFactorize( len, factors );
+            // the tables of the previous stage or of a previous call are taken from the cache
+            plan = DFTPlanCache::getInstance().getPlan( len, complex_elem_size,
+                                                        stage == 0 && inv && real_transform, false );
+            nf = plan->nf;
+            memcpy( factors, plan->factors, sizeof(factors) );
+            itab = &plan->itab[0];
+            wave = (const uchar*)&plan->wave[0];
 
             inplace_transform = factors[0] == factors[nf-1];
-            sz += len*(complex_elem_size + sizeof(int));
             i = nf > 1 && (factors[0] & 1) == 0;
             if( (factors[i] & 1) != 0 && factors[i] > 5 )
                 sz += (factors[i]+1)*complex_elem_size;
@@ -2674,37 +3091,19 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
             }
         }
 
-        ptr = (uchar*)buf;
+        // sz is the scratch space of one thread; the rows or column pairs are split between threads,
+        // each of them allocating its own scratch buffer
         buf.allocate( sz + 32 );
-        if( ptr != (uchar*)buf )
-            prev_len = 0; // because we release the buffer,
-                          // force recalculation of
-                          // twiddle factors and permutation table
-        ptr = (uchar*)buf;
-        if( !spec )
-        {
-            wave = ptr;
-            ptr += len*complex_elem_size;
-            itab = (int*)ptr;
-            ptr = (uchar*)cvAlignPtr( ptr + len*sizeof(int), 16 );
-
-            if( len != prev_len || (!inplace_transform && inv && real_transform))
-                DFTInit( len, nf, factors, itab, complex_elem_size,
-                            wave, stage == 0 && inv && real_transform );
-            // otherwise reuse the tables calculated on the previous stage
-        }
+        ptr = alignPtr( (uchar*)buf, 16 );
 
         if( stage == 0 )
         {
-            uchar* tmp_buf = 0;
             int dptr_offset = 0;
             int dst_full_len = len*elem_size;
             int _flags = (int)inv + (src.channels() != dst.channels() ?
                          DFT_COMPLEX_INPUT_OR_OUTPUT : 0);
             if( use_buf )
             {
-                tmp_buf = ptr;
-                ptr += len*complex_elem_size;
                 if( odd_real && !inv && len > 1 &&
                     !(_flags & DFT_COMPLEX_INPUT_OR_OUTPUT))
                     dptr_offset = elem_size;
@@ -2723,21 +3122,12 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
             if( nonzero_rows <= 0 || nonzero_rows > count )
                 nonzero_rows = count;
 
-            for( i = 0; i < nonzero_rows; i++ )
-            {
-                const uchar* sptr = src.ptr(i);
-                uchar* dptr0 = dst.ptr(i);
-                uchar* dptr = dptr0;
-
-                if( tmp_buf )
-                    dptr = tmp_buf;
+            DFTRowsInvoker invoker( src, dst, dft_func, len, nf, factors, itab, wave, spec, sz,
+                                    use_buf != 0, complex_elem_size, dptr_offset, dst_full_len,
+                                    _flags, scale );
+            parallel_for_( Range(0, nonzero_rows), invoker, (double)nonzero_rows*len/(1 << 14) );
 
-                dft_func( sptr, dptr, len, nf, factors, itab, wave, len, spec, ptr, _flags, scale );
-                if( dptr != dptr0 )
-                    memcpy( dptr0, dptr + dptr_offset, dst_full_len );
-            }
-
-            for( ; i < count; i++ )
+            for( i = nonzero_rows; i < count; i++ )
             {
                 uchar* dptr0 = dst.ptr(i);
                 memset( dptr0, 0, dst_full_len );
@@ -2865,27 +3255,10 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
                 }
             }
 
-            for( i = a; i < b; i += 2 )
-            {
-                if( i+1 < b )
-                {
-                    CopyFrom2Columns( sptr0, src.step, buf0, buf1, len, complex_elem_size );
-                    dft_func( buf1, dbuf1, len, nf, factors, itab,
-                              wave, len, spec, ptr, inv, scale );
-                }
-                else
-                    CopyColumn( sptr0, src.step, buf0, complex_elem_size, len, complex_elem_size );
-
-                dft_func( buf0, dbuf0, len, nf, factors, itab,
-                          wave, len, spec, ptr, inv, scale );
-
-                if( i+1 < b )
-                    CopyTo2Columns( dbuf0, dbuf1, dptr0, dst.step, len, complex_elem_size );
-                else
-                    CopyColumn( dbuf0, complex_elem_size, dptr0, dst.step, len, complex_elem_size );
-                sptr0 += 2*complex_elem_size;
-                dptr0 += 2*complex_elem_size;
-            }
+            DFTColumnsInvoker invoker( sptr0, src.step, dptr0, dst.step, b - a, dft_func,
+                                       len, nf, factors, itab, wave, spec, sz, use_buf != 0,
+                                       complex_elem_size, inv, scale );
+            parallel_for_( Range(0, (b - a + 1)/2), invoker, (double)(b - a)*len/(1 << 14) );
 
             if( stage != 0 )
             {
@@ -2898,7 +3271,6 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
     }
 }
 
-
 void cv::idft( InputArray src, OutputArray dst, int flags, int nonzero_rows )
 {
     dft( src, dst, flags | DFT_INVERSE, nonzero_rows );
@@ -3316,6 +3688,60 @@ static void IDCT_64f(const double* src, int src_step, double* dft_src, double* d
          n, nf, factors, itab, dft_wave, dct_wave, spec, buf);
 }
 
+
+// Rows (stage 0) or columns (stage 1) of cv::dct; every one is an independent 1D transform.
+class DCTInvoker : public ParallelLoopBody
+{
+public:
+    DCTInvoker( const uchar* _sptr, size_t _sstep0, size_t _sstep1,
+                uchar* _dptr, size_t _dstep0, size_t _dstep1,
+                DCTFunc _dct_func, const DFTPlan& _plan, const void* _spec,
+                bool _inplace_transform, int _elem_size ) :
+        sptr(_sptr), sstep0(_sstep0), sstep1(_sstep1), dptr(_dptr), dstep0(_dstep0), dstep1(_dstep1),
+        dct_func(_dct_func), plan(_plan), spec(_spec), inplace_transform(_inplace_transform),
+        elem_size(_elem_size)
+    {
+    }
+
+    void operator()( const Range& range ) const
+    {
+        int len = plan.len, complex_elem_size = elem_size*2;
+        int i = plan.nf > 1 && (plan.factors[0] & 1) == 0;
+        size_t sz = len*elem_size*(inplace_transform ? 1 : 2) + complex_elem_size;
+        if( (plan.factors[i] & 1) != 0 && plan.factors[i] > 5 )
+            sz += (plan.factors[i]+1)*complex_elem_size;
+
+        // RealDFT and CCSIDFT temporarily modify factors[0], so every thread works on its own copy
+        int factors[34];
+        memcpy( factors, plan.factors, sizeof(factors) );
+        AutoBuffer<uchar> buf( sz + 32 );
+        uchar* ptr = alignPtr( (uchar*)buf, 16 );
+        uchar *src_dft_buf = ptr, *dst_dft_buf = ptr;
+        ptr += len*elem_size;
+        if( !inplace_transform )
+        {
+            dst_dft_buf = ptr;
+            ptr += len*elem_size;
+        }
+
+        for( i = range.start; i < range.end; i++ )
+            dct_func( sptr + i*sstep0, (int)sstep1, src_dft_buf, dst_dft_buf,
+                      dptr + i*dstep0, (int)dstep1, len, plan.nf, factors,
+                      &plan.itab[0], &plan.wave[0], &plan.dct_wave[0], spec, ptr );
+    }
+
+private:
+    const uchar* sptr;
+    size_t sstep0, sstep1;
+    uchar* dptr;
+    size_t dstep0, dstep1;
+    DCTFunc dct_func;
+    const DFTPlan& plan;
+    const void* spec;
+    bool inplace_transform;
+    int elem_size;
+};
+
 }
 
 #ifdef HAVE_IPP
@@ -3589,16 +4015,9 @@ void cv::dct( InputArray _src0, OutputArray _dst, int flags )
     int type = src.type(), depth = src.depth();
     void *spec = 0;
 
-    double scale = 1.;
-    int prev_len = 0, nf = 0, stage, end_stage;
-    uchar *src_dft_buf = 0, *dst_dft_buf = 0;
-    uchar *dft_wave = 0, *dct_wave = 0;
-    int* itab = 0;
-    uchar* ptr = 0;
+    int stage, end_stage;
     int elem_size = (int)src.elemSize(), complex_elem_size = elem_size*2;
-    int factors[34], inplace_transform;
-    int i, len, count;
-    AutoBuffer<uchar> buf;
+    int len, count;
 
     CV_Assert( type == CV_32FC1 || type == CV_64FC1 );
     _dst.create( src.rows, src.cols, type );
@@ -3647,70 +4066,20 @@ void cv::dct( InputArray _src0, OutputArray _dst, int flags )
             sstep0 = dstep0 = elem_size;
         }
 
-        if( len != prev_len )
-        {
-            int sz;
-
-            if( len > 1 && (len & 1) )
-                CV_Error( CV_StsNotImplemented, "Odd-size DCT\'s are not implemented" );
-
-            sz = len*elem_size;
-            sz += (len/2 + 1)*complex_elem_size;
-
-            spec = 0;
-            inplace_transform = 1;
-            {
-                sz += len*(complex_elem_size + sizeof(int)) + complex_elem_size;
-
-                nf = DFTFactorize( len, factors );
-                inplace_transform = factors[0] == factors[nf-1];
-
-                i = nf > 1 && (factors[0] & 1) == 0;
-                if( (factors[i] & 1) != 0 && factors[i] > 5 )
-                    sz += (factors[i]+1)*complex_elem_size;
-
-                if( !inplace_transform )
-                    sz += len*elem_size;
-            }
-
-            buf.allocate( sz + 32 );
-            ptr = (uchar*)buf;
+        if( len > 1 && (len & 1) )
+            CV_Error( CV_StsNotImplemented, "Odd-size DCT\'s are not implemented" );
 
-            if( !spec )
-            {
-                dft_wave = ptr;
-                ptr += len*complex_elem_size;
-                itab = (int*)ptr;
-                ptr = (uchar*)cvAlignPtr( ptr + len*sizeof(int), 16 );
-                DFTInit( len, nf, factors, itab, complex_elem_size, dft_wave, inv );
-            }
+        // the tables of the previous stage or of a previous call are taken from the cache
+        Ptr<DFTPlan> plan = DFTPlanCache::getInstance().getPlan( len, complex_elem_size, inv, true );
+        bool inplace_transform = plan->factors[0] == plan->factors[plan->nf-1];
 
-            dct_wave = ptr;
-            ptr += (len/2 + 1)*complex_elem_size;
-            src_dft_buf = dst_dft_buf = ptr;
-            ptr += len*elem_size;
-            if( !inplace_transform )
-            {
-                dst_dft_buf = ptr;
-                ptr += len*elem_size;
-            }
-            DCTInit( len, complex_elem_size, dct_wave, inv );
-            if( !inv )
-                scale += scale;
-            prev_len = len;
-        }
-        // otherwise reuse the tables calculated on the previous stage
-        for( i = 0; i < count; i++ )
-        {
-            dct_func( sptr + i*sstep0, (int)sstep1, src_dft_buf, dst_dft_buf,
-                      dptr + i*dstep0, (int)dstep1, len, nf, factors,
-                      itab, dft_wave, dct_wave, spec, ptr );
-        }
+        DCTInvoker invoker( sptr, sstep0, sstep1, dptr, dstep0, dstep1,
+                            dct_func, *plan, spec, inplace_transform, elem_size );
+        parallel_for_( Range(0, count), invoker, (double)count*len/(1 << 14) );
         src = dst;
     }
 }
 
-
 void cv::idct( InputArray src, OutputArray dst, int flags )
 {
     dct( src, dst, flags | DCT_INVERSE );
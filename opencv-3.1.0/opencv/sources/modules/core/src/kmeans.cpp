@@ -97,9 +97,10 @@ private:
 /*
 k-means center initialization using the following algorithm:
 Arthur & Vassilvitskii (2007) k-means++: The Advantages of Careful Seeding
+If weights are given, the i-th sample counts as weights[i] samples.
 */
 static void generateCentersPP(const Mat& _data, Mat& _out_centers,
-                              int K, RNG& rng, int trials)
+                              int K, RNG& rng, int trials, const float* weights = 0)
 {
     int i, j, k, dims = _data.cols, N = _data.rows;
     const float* data = _data.ptr<float>(0);
@@ -115,7 +116,7 @@ static void generateCentersPP(const Mat& _data, Mat& _out_centers,
     for( i = 0; i < N; i++ )
     {
         dist[i] = normL2Sqr(data + step*i, data + step*centers[0], dims);
-        sum0 += dist[i];
+        sum0 += weights ? dist[i]*weights[i] : dist[i];
     }
 
     for( k = 1; k < K; k++ )
@@ -127,7 +128,7 @@ static void generateCentersPP(const Mat& _data, Mat& _out_centers,
         {
             double p = (double)rng*sum0, s = 0;
             for( i = 0; i < N-1; i++ )
-                if( (p -= dist[i]) <= 0 )
+                if( (p -= weights ? dist[i]*weights[i] : dist[i]) <= 0 )
                     break;
             int ci = i;
 
@@ -135,7 +136,7 @@ static void generateCentersPP(const Mat& _data, Mat& _out_centers,
                          KMeansPPDistanceComputer(tdist2, data, dist, dims, step, step*ci));
             for( i = 0; i < N; i++ )
             {
-                s += tdist2[i];
+                s += weights ? tdist2[i]*weights[i] : tdist2[i];
             }
 
             if( s < bestSum )
@@ -159,6 +160,123 @@ static void generateCentersPP(const Mat& _data, Mat& _out_centers,
     }
 }
 
+class KMeansCandidateDistanceComputer : public ParallelLoopBody
+{
+public:
+    KMeansCandidateDistanceComputer( float *_dist,
+                                     int *_nearest,
+                                     const Mat& _data,
+                                     const int *_candidates,
+                                     int _c0, int _c1 )
+        : dist(_dist),
+          nearest(_nearest),
+          data(_data),
+          candidates(_candidates),
+          c0(_c0), c1(_c1) { }
+
+    void operator()( const cv::Range& range ) const
+    {
+        const int dims = data.cols;
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const float* sample = data.ptr<float>(i);
+            for( int c = c0; c < c1; c++ )
+            {
+                float d = normL2Sqr(sample, data.ptr<float>(candidates[c]), dims);
+                if( d < dist[i] )
+                {
+                    dist[i] = d;
+                    nearest[i] = c;
+                }
+            }
+        }
+    }
+
+private:
+    KMeansCandidateDistanceComputer& operator=(const KMeansCandidateDistanceComputer&); // to quiet MSVC
+
+    float *dist;
+    int *nearest;
+    const Mat& data;
+    const int *candidates;
+    const int c0, c1;
+};
+
+/*
+k-means center initialization using the following algorithm:
+Bahmani et al. (2012) Scalable K-Means++
+Every round samples about K candidates with probability proportional to their distance
+to the candidates chosen so far; kmeans++ then picks K centers out of the candidates,
+each weighted by the number of samples closest to it. This takes ROUNDS+1 parallel passes
+over the data, while kmeans++ on the whole data takes K*trials of them.
+*/
+static void generateCentersParallel(const Mat& data, Mat& _out_centers,
+                                    int K, RNG& rng, int trials)
+{
+    const int ROUNDS = 5;
+    int i, r, N = data.rows, dims = data.cols;
+    double oversampling = K;
+    std::vector<int> candidates, nearest(N, 0);
+    std::vector<float> dist(N, FLT_MAX);
+
+    candidates.push_back((unsigned)rng % N);
+    parallel_for_(Range(0, N),
+                  KMeansCandidateDistanceComputer(&dist[0], &nearest[0], data, &candidates[0], 0, 1));
+
+    for( r = 0; r < ROUNDS; r++ )
+    {
+        double psi = 0;
+        for( i = 0; i < N; i++ )
+            psi += dist[i];
+        if( psi <= 0 )
+            break;
+
+        int c0 = (int)candidates.size();
+        for( i = 0; i < N; i++ )
+            if( (double)rng*psi < oversampling*dist[i] )
+                candidates.push_back(i);
+
+        int c1 = (int)candidates.size();
+        if( c1 > c0 )
+            parallel_for_(Range(0, N),
+                          KMeansCandidateDistanceComputer(&dist[0], &nearest[0], data, &candidates[0], c0, c1));
+    }
+
+    int C = (int)candidates.size();
+    if( C <= K )
+    {
+        // too few distinct samples to oversample from
+        generateCentersPP(data, _out_centers, K, rng, trials);
+        return;
+    }
+
+    Mat cdata(C, dims, CV_32F);
+    std::vector<float> weights(C, 0.f);
+    for( i = 0; i < C; i++ )
+        memcpy(cdata.ptr<float>(i), data.ptr<float>(candidates[i]), dims*sizeof(float));
+    for( i = 0; i < N; i++ )
+        weights[nearest[i]] += 1.f;
+
+    generateCentersPP(cdata, _out_centers, K, rng, trials, &weights[0]);
+}
+
+static void generateCenters(const Mat& data, Mat& centers, int K, int flags,
+                            const std::vector<Vec2f>& box, RNG& rng)
+{
+    const int SPP_TRIALS = 3;
+
+    if( flags & KMEANS_PARALLEL_CENTERS )
+        generateCentersParallel(data, centers, K, rng, SPP_TRIALS);
+    else if( flags & KMEANS_PP_CENTERS )
+        generateCentersPP(data, centers, K, rng, SPP_TRIALS);
+    else
+    {
+        for( int k = 0; k < K; k++ )
+            generateRandomCenter(box, centers.ptr<float>(k), rng);
+    }
+}
+
 class KMeansDistanceComputer : public ParallelLoopBody
 {
 public:
@@ -212,6 +330,257 @@ private:
     const Mat& centers;
 };
 
+// Half of the distance from every center to the closest other center
+class KMeansCenterSeparationComputer : public ParallelLoopBody
+{
+public:
+    KMeansCenterSeparationComputer( double *_separation,
+                                    const Mat& _centers,
+                                    double _eps )
+        : separation(_separation),
+          centers(_centers),
+          eps(_eps)
+    {
+    }
+
+    void operator()( const Range& range ) const
+    {
+        const int K = centers.rows;
+        const int dims = centers.cols;
+
+        for( int k = range.start; k < range.end; k++ )
+        {
+            const float* center = centers.ptr<float>(k);
+            double min_dist = DBL_MAX;
+
+            for( int k1 = 0; k1 < K; k1++ )
+            {
+                if( k1 == k )
+                    continue;
+                double dist = normL2Sqr(center, centers.ptr<float>(k1), dims);
+                min_dist = std::min(min_dist, dist);
+            }
+
+            separation[k] = min_dist < DBL_MAX ? 0.5*std::sqrt(min_dist)*(1 - eps) : DBL_MAX;
+        }
+    }
+
+private:
+    KMeansCenterSeparationComputer& operator=(const KMeansCenterSeparationComputer&); // to quiet MSVC
+
+    double *separation;
+    const Mat& centers;
+    const double eps;
+};
+
+/*
+Label assignment using the bounds from:
+Hamerly (2010) Making k-means even faster
+Every sample keeps a lower bound on the distance to the second closest center. After the centers
+move, the bound is decreased by the largest shift of the other centers, and the search over all
+the centers is only done when the distance to the current center is not below both the bound and
+half the distance to the closest other center. The bounds are kept with a relative margin eps
+that covers the rounding of normL2Sqr, so the labels match the ones of the full search.
+*/
+class KMeansBoundedDistanceComputer : public ParallelLoopBody
+{
+public:
+    KMeansBoundedDistanceComputer( double *_distances,
+                                   int *_labels,
+                                   double *_lower,
+                                   const Mat& _data,
+                                   const Mat& _centers,
+                                   const double *_separation,
+                                   const double *_shift,
+                                   double _eps,
+                                   bool _full )
+        : distances(_distances),
+          labels(_labels),
+          lower(_lower),
+          data(_data),
+          centers(_centers),
+          separation(_separation),
+          eps(_eps),
+          full(_full)
+    {
+        // the largest and the second largest shift
+        shift_max = shift_max2 = 0;
+        k_shift_max = -1;
+        for( int k = 0; !full && k < centers.rows; k++ )
+        {
+            if( _shift[k] > shift_max )
+            {
+                shift_max2 = shift_max;
+                shift_max = _shift[k];
+                k_shift_max = k;
+            }
+            else
+                shift_max2 = std::max(shift_max2, _shift[k]);
+        }
+    }
+
+    void operator()( const Range& range ) const
+    {
+        const int K = centers.rows;
+        const int dims = centers.cols;
+
+        for( int i = range.start; i < range.end; ++i )
+        {
+            const float *sample = data.ptr<float>(i);
+
+            if( !full )
+            {
+                int k = labels[i];
+                double dist = normL2Sqr(sample, centers.ptr<float>(k), dims);
+                double bound = lower[i] - (k == k_shift_max ? shift_max2 : shift_max)*(1 + eps);
+
+                lower[i] = bound;
+                if( std::sqrt(dist)*(1 + eps) < std::max(bound, separation[k]) )
+                {
+                    distances[i] = dist;
+                    continue;
+                }
+            }
+
+            int k_best = 0;
+            double min_dist = DBL_MAX, min_dist2 = DBL_MAX;
+
+            for( int k = 0; k < K; k++ )
+            {
+                const float* center = centers.ptr<float>(k);
+                const double dist = normL2Sqr(sample, center, dims);
+
+                if( min_dist > dist )
+                {
+                    min_dist2 = min_dist;
+                    min_dist = dist;
+                    k_best = k;
+                }
+                else if( min_dist2 > dist )
+                    min_dist2 = dist;
+            }
+
+            distances[i] = min_dist;
+            labels[i] = k_best;
+            lower[i] = min_dist2 < DBL_MAX ? std::sqrt(min_dist2)*(1 - eps) : DBL_MAX;
+        }
+    }
+
+private:
+    KMeansBoundedDistanceComputer& operator=(const KMeansBoundedDistanceComputer&); // to quiet MSVC
+
+    double *distances;
+    int *labels;
+    double *lower;
+    const Mat& data;
+    const Mat& centers;
+    const double *separation;
+    const double eps;
+    const bool full;
+    double shift_max, shift_max2;
+    int k_shift_max;
+};
+
+/*
+Mini-batch k-means:
+Sculley (2010) Web-scale k-means clustering
+Every iteration assigns a random batch of samples to the closest centers and moves each center
+towards its samples with a per-center learning rate of 1/(number of samples seen so far).
+The labels and the compactness are computed over the whole data set at the end.
+*/
+static double kmeansMiniBatch(const Mat& data, int K, Mat& _labels, Mat& best_labels,
+                              const TermCriteria& criteria, int attempts, int flags,
+                              const std::vector<Vec2f>& box, RNG& rng, OutputArray _centers)
+{
+    const int MIN_BATCH_SIZE = 1024, BATCH_SAMPLES_PER_CENTER = 4;
+    int N = data.rows, dims = data.cols;
+    int B = std::min(N, std::max(MIN_BATCH_SIZE, BATCH_SAMPLES_PER_CENTER*K));
+    int* labels = _labels.ptr<int>();
+    Mat centers(K, dims, CV_32F), old_centers(K, dims, CV_32F);
+    Mat batch(B, dims, CV_32F), batch_dists(1, B, CV_64F), dists(1, N, CV_64F);
+    std::vector<int> batch_labels(B), counters(K);
+    double best_compactness = DBL_MAX;
+    int a, iter, i, j, k;
+
+    for( a = 0; a < attempts; a++ )
+    {
+        if( a == 0 && (flags & KMEANS_USE_INITIAL_LABELS) )
+        {
+            centers = Scalar(0);
+            std::fill(counters.begin(), counters.end(), 0);
+            for( i = 0; i < N; i++ )
+            {
+                k = labels[i];
+                CV_Assert( (unsigned)k < (unsigned)K );
+                const float* sample = data.ptr<float>(i);
+                float* center = centers.ptr<float>(k);
+                for( j = 0; j < dims; j++ )
+                    center[j] += sample[j];
+                counters[k]++;
+            }
+            for( k = 0; k < K; k++ )
+            {
+                float* center = centers.ptr<float>(k);
+                if( counters[k] == 0 )
+                {
+                    generateRandomCenter(box, center, rng);
+                    continue;
+                }
+                float scale = 1.f/counters[k];
+                for( j = 0; j < dims; j++ )
+                    center[j] *= scale;
+            }
+        }
+        else
+            generateCenters(data, centers, K, flags, box, rng);
+
+        std::fill(counters.begin(), counters.end(), 0);
+        for( iter = 0; iter < criteria.maxCount; iter++ )
+        {
+            for( i = 0; i < B; i++ )
+                memcpy(batch.ptr<float>(i), data.ptr<float>(rng.uniform(0, N)), dims*sizeof(float));
+
+            parallel_for_(Range(0, B),
+                          KMeansDistanceComputer(batch_dists.ptr<double>(), &batch_labels[0], batch, centers));
+
+            centers.copyTo(old_centers);
+            for( i = 0; i < B; i++ )
+            {
+                k = batch_labels[i];
+                const float* sample = batch.ptr<float>(i);
+                float* center = centers.ptr<float>(k);
+                float eta = 1.f/++counters[k];
+                for( j = 0; j < dims; j++ )
+                    center[j] += eta*(sample[j] - center[j]);
+            }
+
+            double max_center_shift = 0;
+            for( k = 0; k < K; k++ )
+                max_center_shift = std::max(max_center_shift,
+                    (double)normL2Sqr(centers.ptr<float>(k), old_centers.ptr<float>(k), dims));
+            if( max_center_shift <= criteria.epsilon )
+                break;
+        }
+
+        double* dist = dists.ptr<double>();
+        parallel_for_(Range(0, N),
+                      KMeansDistanceComputer(dist, labels, data, centers));
+        double compactness = 0;
+        for( i = 0; i < N; i++ )
+            compactness += dist[i];
+
+        if( compactness < best_compactness )
+        {
+            best_compactness = compactness;
+            if( _centers.needed() )
+                centers.copyTo(_centers);
+            _labels.copyTo(best_labels);
+        }
+    }
+
+    return best_compactness;
+}
+
 }
 
 double cv::kmeans( InputArray _data, int K,
@@ -219,7 +588,6 @@ double cv::kmeans( InputArray _data, int K,
                    TermCriteria criteria, int attempts,
                    int flags, OutputArray _centers )
 {
-    const int SPP_TRIALS = 3;
     Mat data0 = _data.getMat();
     bool isrow = data0.rows == 1;
     int N = isrow ? data0.cols : data0.rows;
@@ -229,6 +597,8 @@ double cv::kmeans( InputArray _data, int K,
     attempts = std::max(attempts, 1);
     CV_Assert( data0.dims <= 2 && type == CV_32F && K > 0 );
     CV_Assert( N >= K );
+    CV_Assert( !((flags & KMEANS_PP_CENTERS) && (flags & KMEANS_PARALLEL_CENTERS)) );
+    CV_Assert( !((flags & KMEANS_USE_BOUNDS) && (flags & KMEANS_MINI_BATCH)) );
 
     Mat data(N, dims, CV_32F, data0.ptr(), isrow ? dims * sizeof(float) : static_cast<size_t>(data0.step));
 
@@ -294,22 +664,31 @@ double cv::kmeans( InputArray _data, int K,
         }
     }
 
+    if( flags & KMEANS_MINI_BATCH )
+        return kmeansMiniBatch(data, K, _labels, best_labels, criteria, attempts, flags, _box, rng, _centers);
+
+    // bounds state of KMEANS_USE_BOUNDS
+    bool use_bounds = (flags & KMEANS_USE_BOUNDS) != 0 && K > 1;
+    double bounds_eps = std::max(dims, 4)*(double)FLT_EPSILON;
+    std::vector<double> lower, separation, shift;
+    if( use_bounds )
+    {
+        lower.resize(N);
+        separation.resize(K);
+        shift.resize(K);
+    }
+
     for( a = 0; a < attempts; a++ )
     {
         double max_center_shift = DBL_MAX;
+        bool bounds_ready = false;
         for( iter = 0;; )
         {
             swap(centers, old_centers);
 
             if( iter == 0 && (a > 0 || !(flags & KMEANS_USE_INITIAL_LABELS)) )
             {
-                if( flags & KMEANS_PP_CENTERS )
-                    generateCentersPP(data, centers, K, rng, SPP_TRIALS);
-                else
-                {
-                    for( k = 0; k < K; k++ )
-                        generateRandomCenter(_box, centers.ptr<float>(k), rng);
-                }
+                generateCenters(data, centers, K, flags, _box, rng);
             }
             else
             {
@@ -396,6 +775,8 @@ double cv::kmeans( InputArray _data, int K,
                     counters[max_k]--;
                     counters[k]++;
                     labels[farthest_i] = k;
+                    // the lower bound of the moved sample is not valid for its new center
+                    bounds_ready = false;
                     sample = data.ptr<float>(farthest_i);
 
                     for( j = 0; j < dims; j++ )
@@ -424,6 +805,8 @@ double cv::kmeans( InputArray _data, int K,
                             dist += t*t;
                         }
                         max_center_shift = std::max(max_center_shift, dist);
+                        if( use_bounds )
+                            shift[k] = std::sqrt(dist);
                     }
                 }
             }
@@ -434,8 +817,19 @@ double cv::kmeans( InputArray _data, int K,
             // assign labels
             Mat dists(1, N, CV_64F);
             double* dist = dists.ptr<double>(0);
-            parallel_for_(Range(0, N),
-                         KMeansDistanceComputer(dist, labels, data, centers));
+            if( use_bounds )
+            {
+                if( bounds_ready )
+                    parallel_for_(Range(0, K),
+                                  KMeansCenterSeparationComputer(&separation[0], centers, bounds_eps));
+                parallel_for_(Range(0, N),
+                              KMeansBoundedDistanceComputer(dist, labels, &lower[0], data, centers,
+                                                            &separation[0], &shift[0], bounds_eps, !bounds_ready));
+                bounds_ready = true;
+            }
+            else
+                parallel_for_(Range(0, N),
+                             KMeansDistanceComputer(dist, labels, data, centers));
             compactness = 0;
             for( i = 0; i < N; i++ )
             {
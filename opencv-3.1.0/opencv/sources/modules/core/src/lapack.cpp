@@ -578,6 +578,604 @@ static void JacobiSVD(double* At, size_t astep, double* W, double* Vt, size_t vs
     JacobiSVDImpl_(At, astep, W, Vt, vstep, m, n, !Vt ? 0 : n1 < 0 ? n : n1, DBL_MIN, DBL_EPSILON*10);
 }
 
+/////////////////// Householder reduction + implicit QR/QL iterations ///////////////////
+//
+// For large matrices the one-sided Jacobi SVD and the Jacobi eigen solver above need many
+// O(n^3) sweeps and run on a single thread. The functions below reduce the matrix to
+// bidiagonal (SVD) or tridiagonal (eigen) form with Householder reflections, then diagonalize
+// it with the implicit shifted QR (Golub-Kahan) or QL iterations, as in LAPACK/EISPACK.
+// Everything is computed in double precision. The reflections and the Givens rotations are
+// applied to the row-major factors row by row or column block by column block with
+// parallel_for_; the rotations of every QR/QL step are recorded first and then applied to
+// the factors at once, one column block at a time.
+
+enum { LAPACK_PARALLEL_GRAIN = 1 << 16, ROTATION_BLOCK = 256 };
+
+// the smallest sizes for which the Householder-based solvers are used instead of Jacobi
+enum { SVD_QR_MIN_SIZE = 32, EIGEN_QL_MIN_SIZE = 32 };
+
+// Generates the reflection H = I - tau*v*v', v[0] = 1, so that H*x = beta*e1. x is replaced by v.
+static double makeHouseholder( double* x, int len, double& tau )
+{
+    double alpha = x[0], xnorm = 0;
+    int i;
+    for( i = 1; i < len; i++ )
+        xnorm += x[i]*x[i];
+    x[0] = 1;
+    if( xnorm == 0 )
+    {
+        tau = 0;
+        return alpha;
+    }
+    double beta = std::sqrt(alpha*alpha + xnorm);
+    if( alpha > 0 )
+        beta = -beta;
+    tau = (beta - alpha)/beta;
+    double scale = 1./(alpha - beta);
+    for( i = 1; i < len; i++ )
+        x[i] *= scale;
+    return beta;
+}
+
+// row[ofs:ofs+len] -= tau*(row[ofs:ofs+len].v)*v for every row in the range
+class ReflectRowsInvoker : public ParallelLoopBody
+{
+public:
+    ReflectRowsInvoker( double* _a, size_t _astep, int _ofs, const double* _v, int _len, double _tau )
+        : a(_a), astep(_astep), ofs(_ofs), v(_v), len(_len), tau(_tau) {}
+
+    void operator()( const Range& range ) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            double* row = a + astep*i + ofs;
+            double s = 0;
+            int k;
+            for( k = 0; k < len; k++ )
+                s += row[k]*v[k];
+            s *= tau;
+            for( k = 0; k < len; k++ )
+                row[k] -= s*v[k];
+        }
+    }
+
+private:
+    double* a;
+    size_t astep;
+    int ofs;
+    const double* v;
+    int len;
+    double tau;
+};
+
+// A[rows, cols] = H*A[rows, cols], H = I - tau*v*v', for the columns in the range;
+// v has one element per row of the block
+class ReflectColumnsInvoker : public ParallelLoopBody
+{
+public:
+    ReflectColumnsInvoker( double* _a, size_t _astep, int _row0, const double* _v, int _len, double _tau )
+        : a(_a), astep(_astep), row0(_row0), v(_v), len(_len), tau(_tau) {}
+
+    void operator()( const Range& range ) const
+    {
+        int i, j, j0, j1, ncols = range.end - range.start;
+        double buf[ROTATION_BLOCK];
+
+        for( j0 = 0; j0 < ncols; j0 += ROTATION_BLOCK )
+        {
+            j1 = std::min(j0 + (int)ROTATION_BLOCK, ncols);
+            for( j = j0; j < j1; j++ )
+                buf[j - j0] = 0;
+            for( i = 0; i < len; i++ )
+            {
+                const double* row = a + astep*(row0 + i) + range.start;
+                double vi = v[i];
+                for( j = j0; j < j1; j++ )
+                    buf[j - j0] += vi*row[j];
+            }
+            for( i = 0; i < len; i++ )
+            {
+                double* row = a + astep*(row0 + i) + range.start;
+                double vi = tau*v[i];
+                for( j = j0; j < j1; j++ )
+                    row[j] -= vi*buf[j - j0];
+            }
+        }
+    }
+
+private:
+    double* a;
+    size_t astep;
+    int row0;
+    const double* v;
+    int len;
+    double tau;
+};
+
+// Applies a recorded sequence of plane rotations to the rows of a matrix, one column block at a time:
+// (row[i0], row[i1]) = (c*row[i0] + s*row[i1], c*row[i1] - s*row[i0])
+struct PlaneRotation
+{
+    int i0, i1;
+    double c, s;
+};
+
+class RotateRowsInvoker : public ParallelLoopBody
+{
+public:
+    RotateRowsInvoker( double* _a, size_t _astep, const PlaneRotation* _rot, int _nrot )
+        : a(_a), astep(_astep), rot(_rot), nrot(_nrot) {}
+
+    void operator()( const Range& range ) const
+    {
+        for( int j0 = range.start; j0 < range.end; j0 += ROTATION_BLOCK )
+        {
+            int j1 = std::min(j0 + (int)ROTATION_BLOCK, range.end);
+            for( int r = 0; r < nrot; r++ )
+            {
+                double* a0 = a + astep*rot[r].i0;
+                double* a1 = a + astep*rot[r].i1;
+                double c = rot[r].c, s = rot[r].s;
+                for( int j = j0; j < j1; j++ )
+                {
+                    double t0 = a0[j], t1 = a1[j];
+                    a0[j] = c*t0 + s*t1;
+                    a1[j] = c*t1 - s*t0;
+                }
+            }
+        }
+    }
+
+private:
+    double* a;
+    size_t astep;
+    const PlaneRotation* rot;
+    int nrot;
+};
+
+static void rotateRows( Mat& a, std::vector<PlaneRotation>& rot )
+{
+    if( a.empty() || rot.empty() )
+        return;
+    parallel_for_(Range(0, a.cols), RotateRowsInvoker(a.ptr<double>(), a.step1(), &rot[0], (int)rot.size()),
+                  (double)a.cols*rot.size()/LAPACK_PARALLEL_GRAIN);
+    rot.clear();
+}
+
+static void reflectRows( Mat& a, int row0, int row1, int ofs, const double* v, int len, double tau )
+{
+    if( tau == 0 || row0 >= row1 )
+        return;
+    parallel_for_(Range(row0, row1), ReflectRowsInvoker(a.ptr<double>(), a.step1(), ofs, v, len, tau),
+                  (double)(row1 - row0)*len/LAPACK_PARALLEL_GRAIN);
+}
+
+// Symmetric tridiagonalization helpers: p = tau*B*v and B -= v*w' + w*v'
+class SymMatVecInvoker : public ParallelLoopBody
+{
+public:
+    SymMatVecInvoker( const double* _b, size_t _bstep, const double* _v, double* _p, int _len, double _tau )
+        : b(_b), bstep(_bstep), v(_v), p(_p), len(_len), tau(_tau) {}
+
+    void operator()( const Range& range ) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const double* row = b + bstep*i;
+            double s = 0;
+            for( int k = 0; k < len; k++ )
+                s += row[k]*v[k];
+            p[i] = tau*s;
+        }
+    }
+
+private:
+    const double* b;
+    size_t bstep;
+    const double* v;
+    double* p;
+    int len;
+    double tau;
+};
+
+class SymRank2UpdateInvoker : public ParallelLoopBody
+{
+public:
+    SymRank2UpdateInvoker( double* _b, size_t _bstep, const double* _v, const double* _w, int _len )
+        : b(_b), bstep(_bstep), v(_v), w(_w), len(_len) {}
+
+    void operator()( const Range& range ) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            double* row = b + bstep*i;
+            double vi = v[i], wi = w[i];
+            for( int k = 0; k < len; k++ )
+                row[k] -= vi*w[k] + wi*v[k];
+        }
+    }
+
+private:
+    double* b;
+    size_t bstep;
+    const double* v;
+    const double* w;
+    int len;
+};
+
+/*
+  Eigenvalues and eigenvectors of a symmetric matrix: Householder tridiagonalization followed by
+  the implicit QL iterations (EISPACK tred2/tql2). The eigenvectors are stored as the rows of E,
+  the eigenvalues are sorted in descending order.
+*/
+static void SymmetricQLEigen( Mat& a, double* W, Mat& E )
+{
+    int n = a.rows, i, k, l;
+    bool wantv = !E.empty();
+    size_t astep = a.step1();
+    std::vector<double> _e(n), _tau(n), _p(n), _w(n);
+    double* e = &_e[0];
+    double* tau = &_tau[0];
+
+    // A = Q*T*Q', the reflection vectors are stored in the upper triangle
+    for( k = 0; k < n - 2; k++ )
+    {
+        int len = n - k - 1;
+        double* v = a.ptr<double>(k) + k + 1;
+        W[k] = a.at<double>(k, k);
+        e[k] = makeHouseholder(v, len, tau[k]);
+        if( tau[k] == 0 )
+            continue;
+
+        double* b = a.ptr<double>(k + 1) + k + 1;
+        double* p = &_p[0];
+        double* w = &_w[0];
+        double K = 0;
+        parallel_for_(Range(0, len), SymMatVecInvoker(b, astep, v, p, len, tau[k]),
+                      (double)len*len/LAPACK_PARALLEL_GRAIN);
+        for( i = 0; i < len; i++ )
+            K += p[i]*v[i];
+        K *= 0.5*tau[k];
+        for( i = 0; i < len; i++ )
+            w[i] = p[i] - K*v[i];
+        parallel_for_(Range(0, len), SymRank2UpdateInvoker(b, astep, v, w, len),
+                      (double)len*len/LAPACK_PARALLEL_GRAIN);
+    }
+    if( n > 1 )
+    {
+        W[n-2] = a.at<double>(n-2, n-2);
+        e[n-2] = a.at<double>(n-2, n-1);
+    }
+    W[n-1] = a.at<double>(n-1, n-1);
+    e[n-1] = 0;
+
+    // E = Q' = H(n-3)*...*H(0)
+    if( wantv )
+    {
+        setIdentity(E);
+        for( k = n - 3; k >= 0; k-- )
+            reflectRows(E, k + 1, n, k + 1, a.ptr<double>(k) + k + 1, n - k - 1, tau[k]);
+    }
+
+    // QL iterations on the tridiagonal matrix, diagonal W, off-diagonal e
+    const double eps = DBL_EPSILON;
+    double f = 0, tst1 = 0;
+    std::vector<PlaneRotation> rot;
+
+    for( l = 0; l < n; l++ )
+    {
+        tst1 = std::max(tst1, std::abs(W[l]) + std::abs(e[l]));
+        int m = l;
+        while( m < n - 1 && std::abs(e[m]) > eps*tst1 )
+            m++;
+
+        for( int iter = 0; m > l && iter < 60; iter++ )
+        {
+            double g = W[l];
+            double p = (W[l+1] - g)/(2*e[l]);
+            double r = hypot(p, 1.);
+            if( p < 0 )
+                r = -r;
+            W[l] = e[l]/(p + r);
+            W[l+1] = e[l]*(p + r);
+            double dl1 = W[l+1], h = g - W[l];
+            for( i = l + 2; i < n; i++ )
+                W[i] -= h;
+            f += h;
+
+            p = W[m];
+            double c = 1, c2 = 1, c3 = 1, el1 = e[l+1], s = 0, s2 = 0;
+            for( i = m - 1; i >= l; i-- )
+            {
+                c3 = c2;
+                c2 = c;
+                s2 = s;
+                g = c*e[i];
+                h = c*p;
+                r = hypot(p, e[i]);
+                e[i+1] = s*r;
+                s = e[i]/r;
+                c = p/r;
+                p = c*W[i] - s*g;
+                W[i+1] = h + s*(c*g + s*W[i]);
+                if( wantv )
+                {
+                    PlaneRotation pr = { i, i + 1, c, -s };
+                    rot.push_back(pr);
+                }
+            }
+            p = -s*s2*c3*el1*e[l]/dl1;
+            e[l] = s*p;
+            W[l] = c*p;
+            rotateRows(E, rot);
+
+            if( !(std::abs(e[l]) > eps*tst1) )
+                break;
+        }
+        W[l] += f;
+        e[l] = 0;
+    }
+
+    // sort eigenvalues & eigenvectors
+    for( k = 0; k < n - 1; k++ )
+    {
+        int m = k;
+        for( i = k + 1; i < n; i++ )
+            if( W[m] < W[i] )
+                m = i;
+        if( k != m )
+        {
+            std::swap(W[m], W[k]);
+            if( wantv )
+                for( i = 0; i < n; i++ )
+                    std::swap(E.at<double>(m, i), E.at<double>(k, i));
+        }
+    }
+}
+
+/*
+  Singular value decomposition of A (m x n, m >= n), passed transposed in At (n x m):
+  Golub-Kahan Householder bidiagonalization followed by the implicit shifted QR iterations
+  (LINPACK dsvdc). On output the first n1 rows of Ut are the left singular vectors,
+  the rows of Vt are the right singular vectors, W is sorted in descending order.
+  Ut must have max(n, n1) rows, its first n rows are At.
+*/
+static void BidiagQRSVD( Mat& Ut, double* W, Mat& Vt, int m, int n, int n1 )
+{
+    int i, j, k;
+    bool wantuv = !Vt.empty();
+    size_t ustep = Ut.step1();
+    std::vector<double> _e(n), _tau(n), _gtau(n), _g(n*n);
+    double* e = &_e[0];
+    double* tau = &_tau[0];
+    double* gtau = &_gtau[0];
+    double* g = &_g[0];
+
+    // A = H(0)*...*H(n-1)*B*G(n-3)*...*G(0); the left reflection vectors are stored in the rows of At,
+    // the right ones in g
+    for( k = 0; k < n; k++ )
+    {
+        double* v = Ut.ptr<double>(k) + k;
+        W[k] = makeHouseholder(v, m - k, tau[k]);
+        reflectRows(Ut, k + 1, n, k, v, m - k, tau[k]);
+
+        if( k < n - 2 )
+        {
+            double* gk = g + k*n;
+            int len = n - k - 1;
+            for( i = 0; i < len; i++ )
+                gk[i] = Ut.at<double>(k + 1 + i, k);
+            e[k] = makeHouseholder(gk, len, gtau[k]);
+            if( gtau[k] != 0 )
+                parallel_for_(Range(k + 1, m), ReflectColumnsInvoker(Ut.ptr<double>(), ustep, k + 1, gk, len, gtau[k]),
+                              (double)len*(m - k - 1)/LAPACK_PARALLEL_GRAIN);
+        }
+        else if( k == n - 2 )
+            e[k] = Ut.at<double>(k + 1, k);
+    }
+    e[n-1] = 0;
+
+    if( wantuv )
+    {
+        // Vt = G(n-3)*...*G(0)
+        setIdentity(Vt);
+        for( k = n - 3; k >= 0; k-- )
+            reflectRows(Vt, k + 1, n, k + 1, g + k*n, n - k - 1, gtau[k]);
+
+        // Ut = first n1 rows of H(n-1)*...*H(0)
+        std::vector<double> v(m);
+        for( i = n; i < n1; i++ )
+        {
+            double* row = Ut.ptr<double>(i);
+            for( j = 0; j < m; j++ )
+                row[j] = 0;
+            row[i] = 1;
+        }
+        for( k = n - 1; k >= 0; k-- )
+        {
+            double* row = Ut.ptr<double>(k);
+            for( j = k; j < m; j++ )
+            {
+                v[j - k] = row[j];
+                row[j] = 0;
+            }
+            for( j = 0; j < k; j++ )
+                row[j] = 0;
+            row[k] = 1;
+            reflectRows(Ut, k, std::max(n, n1), k, &v[0], m - k, tau[k]);
+        }
+    }
+
+    // implicit QR iterations on the bidiagonal matrix, diagonal W, superdiagonal e
+    const double eps = DBL_EPSILON, tiny = DBL_MIN/DBL_EPSILON;
+    int p = n, iter = 0, max_iter = 75*n;
+    std::vector<PlaneRotation> urot, vrot;
+
+    while( p > 0 && iter < max_iter )
+    {
+        int kase;
+        for( k = p - 2; k >= 0; k-- )
+        {
+            if( std::abs(e[k]) <= tiny + eps*(std::abs(W[k]) + std::abs(W[k+1])) )
+            {
+                e[k] = 0;
+                break;
+            }
+        }
+        if( k == p - 2 )
+            kase = 4;
+        else
+        {
+            int ks;
+            for( ks = p - 1; ks > k; ks-- )
+            {
+                double t = (ks != p ? std::abs(e[ks]) : 0.) + (ks != k + 1 ? std::abs(e[ks-1]) : 0.);
+                if( std::abs(W[ks]) <= tiny + eps*t )
+                {
+                    W[ks] = 0;
+                    break;
+                }
+            }
+            if( ks == k )
+                kase = 3;
+            else if( ks == p - 1 )
+                kase = 1;
+            else
+            {
+                kase = 2;
+                k = ks;
+            }
+        }
+        k++;
+
+        if( kase == 1 )
+        {
+            // deflate negligible W[p-1]
+            double f = e[p-2];
+            e[p-2] = 0;
+            for( j = p - 2; j >= k; j-- )
+            {
+                double t = hypot(W[j], f), cs = W[j]/t, sn = f/t;
+                W[j] = t;
+                if( j != k )
+                {
+                    f = -sn*e[j-1];
+                    e[j-1] = cs*e[j-1];
+                }
+                PlaneRotation r = { j, p - 1, cs, sn };
+                vrot.push_back(r);
+            }
+        }
+        else if( kase == 2 )
+        {
+            // split at negligible W[k-1]
+            double f = e[k-1];
+            e[k-1] = 0;
+            for( j = k; j < p; j++ )
+            {
+                double t = hypot(W[j], f), cs = W[j]/t, sn = f/t;
+                W[j] = t;
+                f = -sn*e[j];
+                e[j] = cs*e[j];
+                PlaneRotation r = { j, k - 1, cs, sn };
+                urot.push_back(r);
+            }
+        }
+        else if( kase == 3 )
+        {
+            // one QR step
+            double scale = std::max(std::max(std::max(std::max(std::abs(W[p-1]), std::abs(W[p-2])),
+                                    std::abs(e[p-2])), std::abs(W[k])), std::abs(e[k]));
+            double sp = W[p-1]/scale, spm1 = W[p-2]/scale, epm1 = e[p-2]/scale;
+            double sk = W[k]/scale, ek = e[k]/scale;
+            double b = ((spm1 + sp)*(spm1 - sp) + epm1*epm1)/2, c = (sp*epm1)*(sp*epm1), shift = 0;
+            if( b != 0 || c != 0 )
+            {
+                shift = std::sqrt(b*b + c);
+                if( b < 0 )
+                    shift = -shift;
+                shift = c/(b + shift);
+            }
+            double f = (sk + sp)*(sk - sp) + shift, gg = sk*ek;
+            for( j = k; j < p - 1; j++ )
+            {
+                double t = hypot(f, gg), cs = f/t, sn = gg/t;
+                if( j != k )
+                    e[j-1] = t;
+                f = cs*W[j] + sn*e[j];
+                e[j] = cs*e[j] - sn*W[j];
+                gg = sn*W[j+1];
+                W[j+1] = cs*W[j+1];
+                PlaneRotation rv = { j, j + 1, cs, sn };
+                vrot.push_back(rv);
+
+                t = hypot(f, gg);
+                cs = f/t;
+                sn = gg/t;
+                W[j] = t;
+                f = cs*e[j] + sn*W[j+1];
+                W[j+1] = -sn*e[j] + cs*W[j+1];
+                gg = sn*e[j+1];
+                e[j+1] = cs*e[j+1];
+                PlaneRotation ru = { j, j + 1, cs, sn };
+                urot.push_back(ru);
+            }
+            e[p-2] = f;
+            iter++;
+        }
+        else
+        {
+            // convergence: make the singular value positive
+            if( W[k] <= 0 )
+            {
+                W[k] = W[k] < 0 ? -W[k] : 0.;
+                if( wantuv )
+                {
+                    double* row = Vt.ptr<double>(k);
+                    for( j = 0; j < n; j++ )
+                        row[j] = -row[j];
+                }
+            }
+            p--;
+        }
+
+        if( wantuv )
+        {
+            rotateRows(Vt, vrot);
+            if( !urot.empty() )
+            {
+                Mat u = Ut.rowRange(0, n);
+                rotateRows(u, urot);
+            }
+        }
+        else
+        {
+            vrot.clear();
+            urot.clear();
+        }
+    }
+
+    // sort singular values & vectors
+    for( k = 0; k < n - 1; k++ )
+    {
+        int m1 = k;
+        for( i = k + 1; i < n; i++ )
+            if( W[m1] < W[i] )
+                m1 = i;
+        if( k != m1 )
+        {
+            std::swap(W[m1], W[k]);
+            if( wantuv )
+            {
+                for( i = 0; i < n; i++ )
+                    std::swap(Vt.at<double>(m1, i), Vt.at<double>(k, i));
+                for( i = 0; i < m; i++ )
+                    std::swap(Ut.at<double>(m1, i), Ut.at<double>(k, i));
+            }
+        }
+    }
+}
+
 /* y[0:m,0:n] += diag(a[0:1,0:m]) * x[0:m,0:n] */
 template<typename T1, typename T2, typename T3> static void
 MatrAXPY( int m, int n, const T1* x, int dx,
@@ -1339,6 +1937,21 @@ bool cv::eigen( InputArray _src, OutputArray _evals, OutputArray _evects )
         v = _evects.getMat();
     }
 
+    if( n >= EIGEN_QL_MIN_SIZE )
+    {
+        Mat a, e;
+        AutoBuffer<double> w(n);
+        src.convertTo(a, CV_64F);
+        completeSymm(a);
+        if( _evects.needed() )
+            e.create(n, n, CV_64F);
+        SymmetricQLEigen(a, w, e);
+        if( _evects.needed() )
+            e.convertTo(v, type);
+        Mat(n, 1, CV_64F, (double*)w).convertTo(_evals, type);
+        return true;
+    }
+
     size_t elemSize = src.elemSize(), astep = alignSize(n*elemSize, 16);
     AutoBuffer<uchar> buf(n*astep + n*5*elemSize + 32);
     uchar* ptr = alignPtr((uchar*)buf, 16);
@@ -1400,7 +2013,22 @@ static void _SVDcompute( InputArray _aarr, OutputArray _w,
     else
         src.copyTo(temp_a);
 
-    if( type == CV_32F )
+    if( n >= SVD_QR_MIN_SIZE )
+    {
+        Mat u(urows, m, CV_64F), ua = u.rowRange(0, n), v;
+        AutoBuffer<double> w(n);
+        temp_a.convertTo(ua, CV_64F);
+        if( compute_uv )
+            v.create(n, n, CV_64F);
+        BidiagQRSVD(u, w, v, m, n, compute_uv ? urows : 0);
+        Mat(n, 1, CV_64F, (double*)w).convertTo(temp_w, type);
+        if( compute_uv )
+        {
+            u.convertTo(temp_u, type);
+            v.convertTo(temp_v, type);
+        }
+    }
+    else if( type == CV_32F )
     {
         JacobiSVD(temp_a.ptr<float>(), temp_u.step, temp_w.ptr<float>(),
               temp_v.ptr<float>(), temp_v.step, m, n, compute_uv ? urows : 0);
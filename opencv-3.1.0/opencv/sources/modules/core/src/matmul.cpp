@@ -692,6 +692,327 @@ static void GEMMStore_64fc( const Complexd* c_data, size_t c_step,
     GEMMStore(c_data, c_step, d_buf, d_buf_step, d_data, d_step, d_size, alpha, beta, flags);
 }
 
+/****************************************************************************************\
+*                        Packed register-blocked float GEMM                              *
+\****************************************************************************************/
+
+// The micro-kernel keeps a GEMM_MR x GEMM_NR block of D in registers while it walks
+// a packed GEMM_KC-long sliver of A and B. One GEMM_KC x GEMM_NR panel of B stays in L1,
+// one GEMM_MC x GEMM_KC block of A stays in L2. Each parallel task owns a GEMM_MC x GEMM_NC tile of D.
+enum
+{
+    GEMM_MR = 6, GEMM_NR = 16,
+    GEMM_KC = 256, GEMM_MC = 96, GEMM_NC = 256
+};
+
+#if CV_SSE2
+
+// op(A)(i,k) = a[i*a_step0 + k*a_step1]. The mc x kc block is stored as GEMM_MR-row panels,
+// k-major inside a panel; the last panel is padded with zeros.
+static void
+GEMMPackA_32f( const float* a, size_t a_step0, size_t a_step1, int mc, int kc, float* dst )
+{
+    for( int i = 0; i < mc; i += GEMM_MR )
+    {
+        int r, mr = std::min( mc - i, (int)GEMM_MR );
+        const float* a_i = a + i*a_step0;
+
+        for( int k = 0; k < kc; k++, dst += GEMM_MR )
+        {
+            const float* a_ik = a_i + k*a_step1;
+            for( r = 0; r < mr; r++ )
+                dst[r] = a_ik[r*a_step0];
+            for( ; r < GEMM_MR; r++ )
+                dst[r] = 0.f;
+        }
+    }
+}
+
+// op(B)(k,j) = b[k*b_step0 + j*b_step1]. The kc x nc block is stored as GEMM_NR-column panels,
+// k-major inside a panel; the last panel is padded with zeros.
+static void
+GEMMPackB_32f( const float* b, size_t b_step0, size_t b_step1, int kc, int nc, float* dst )
+{
+    for( int j = 0; j < nc; j += GEMM_NR )
+    {
+        int c, nr = std::min( nc - j, (int)GEMM_NR );
+        const float* b_j = b + j*b_step1;
+
+        if( b_step1 == 1 && nr == GEMM_NR )
+        {
+            for( int k = 0; k < kc; k++, dst += GEMM_NR )
+                memcpy( dst, b_j + k*b_step0, GEMM_NR*sizeof(dst[0]) );
+            continue;
+        }
+
+        for( int k = 0; k < kc; k++, dst += GEMM_NR )
+        {
+            const float* b_kj = b_j + k*b_step0;
+            for( c = 0; c < nr; c++ )
+                dst[c] = b_kj[c*b_step1];
+            for( ; c < GEMM_NR; c++ )
+                dst[c] = 0.f;
+        }
+    }
+}
+
+// d[r*d_step + c] += sum_k a[k*GEMM_MR + r]*b[k*GEMM_NR + c] over one 6 x 8 half of the register tile.
+// The SSE register file only holds half of the tile, so the full kernel runs this twice.
+static void
+GEMMKernelHalf_32f_SSE2( int kc, const float* a, const float* b, float* d, size_t d_step )
+{
+    __m128 d00 = _mm_setzero_ps(), d01 = _mm_setzero_ps();
+    __m128 d10 = _mm_setzero_ps(), d11 = _mm_setzero_ps();
+    __m128 d20 = _mm_setzero_ps(), d21 = _mm_setzero_ps();
+    __m128 d30 = _mm_setzero_ps(), d31 = _mm_setzero_ps();
+    __m128 d40 = _mm_setzero_ps(), d41 = _mm_setzero_ps();
+    __m128 d50 = _mm_setzero_ps(), d51 = _mm_setzero_ps();
+
+    for( int k = 0; k < kc; k++, a += GEMM_MR, b += GEMM_NR )
+    {
+        __m128 b0 = _mm_load_ps(b), b1 = _mm_load_ps(b + 4), t;
+        t = _mm_load1_ps(a);
+        d00 = _mm_add_ps(d00, _mm_mul_ps(t, b0)); d01 = _mm_add_ps(d01, _mm_mul_ps(t, b1));
+        t = _mm_load1_ps(a + 1);
+        d10 = _mm_add_ps(d10, _mm_mul_ps(t, b0)); d11 = _mm_add_ps(d11, _mm_mul_ps(t, b1));
+        t = _mm_load1_ps(a + 2);
+        d20 = _mm_add_ps(d20, _mm_mul_ps(t, b0)); d21 = _mm_add_ps(d21, _mm_mul_ps(t, b1));
+        t = _mm_load1_ps(a + 3);
+        d30 = _mm_add_ps(d30, _mm_mul_ps(t, b0)); d31 = _mm_add_ps(d31, _mm_mul_ps(t, b1));
+        t = _mm_load1_ps(a + 4);
+        d40 = _mm_add_ps(d40, _mm_mul_ps(t, b0)); d41 = _mm_add_ps(d41, _mm_mul_ps(t, b1));
+        t = _mm_load1_ps(a + 5);
+        d50 = _mm_add_ps(d50, _mm_mul_ps(t, b0)); d51 = _mm_add_ps(d51, _mm_mul_ps(t, b1));
+    }
+
+    _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), d00));
+    _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), d01));
+    d += d_step;
+    _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), d10));
+    _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), d11));
+    d += d_step;
+    _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), d20));
+    _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), d21));
+    d += d_step;
+    _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), d30));
+    _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), d31));
+    d += d_step;
+    _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), d40));
+    _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), d41));
+    d += d_step;
+    _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), d50));
+    _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), d51));
+}
+
+static void
+GEMMKernel_32f_SSE2( int kc, const float* a, const float* b, float* d, size_t d_step )
+{
+    GEMMKernelHalf_32f_SSE2( kc, a, b, d, d_step );
+    GEMMKernelHalf_32f_SSE2( kc, a, b + 8, d + 8, d_step );
+}
+
+#if CV_AVX2
+
+#if CV_FMA3
+#define GEMM_FMADD256(a, b, c) _mm256_fmadd_ps(a, b, c)
+#else
+#define GEMM_FMADD256(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+
+// d[r*d_step + c] += sum_k a[k*GEMM_MR + r]*b[k*GEMM_NR + c] over the whole 6 x 16 register tile.
+static void
+GEMMKernel_32f_AVX2( int kc, const float* a, const float* b, float* d, size_t d_step )
+{
+    __m256 d00 = _mm256_setzero_ps(), d01 = _mm256_setzero_ps();
+    __m256 d10 = _mm256_setzero_ps(), d11 = _mm256_setzero_ps();
+    __m256 d20 = _mm256_setzero_ps(), d21 = _mm256_setzero_ps();
+    __m256 d30 = _mm256_setzero_ps(), d31 = _mm256_setzero_ps();
+    __m256 d40 = _mm256_setzero_ps(), d41 = _mm256_setzero_ps();
+    __m256 d50 = _mm256_setzero_ps(), d51 = _mm256_setzero_ps();
+
+    for( int k = 0; k < kc; k++, a += GEMM_MR, b += GEMM_NR )
+    {
+        __m256 b0 = _mm256_load_ps(b), b1 = _mm256_load_ps(b + 8), t;
+        t = _mm256_broadcast_ss(a);
+        d00 = GEMM_FMADD256(t, b0, d00); d01 = GEMM_FMADD256(t, b1, d01);
+        t = _mm256_broadcast_ss(a + 1);
+        d10 = GEMM_FMADD256(t, b0, d10); d11 = GEMM_FMADD256(t, b1, d11);
+        t = _mm256_broadcast_ss(a + 2);
+        d20 = GEMM_FMADD256(t, b0, d20); d21 = GEMM_FMADD256(t, b1, d21);
+        t = _mm256_broadcast_ss(a + 3);
+        d30 = GEMM_FMADD256(t, b0, d30); d31 = GEMM_FMADD256(t, b1, d31);
+        t = _mm256_broadcast_ss(a + 4);
+        d40 = GEMM_FMADD256(t, b0, d40); d41 = GEMM_FMADD256(t, b1, d41);
+        t = _mm256_broadcast_ss(a + 5);
+        d50 = GEMM_FMADD256(t, b0, d50); d51 = GEMM_FMADD256(t, b1, d51);
+    }
+
+    _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), d00));
+    _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), d01));
+    d += d_step;
+    _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), d10));
+    _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), d11));
+    d += d_step;
+    _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), d20));
+    _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), d21));
+    d += d_step;
+    _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), d30));
+    _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), d31));
+    d += d_step;
+    _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), d40));
+    _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), d41));
+    d += d_step;
+    _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), d50));
+    _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), d51));
+}
+
+#undef GEMM_FMADD256
+
+#endif
+
+typedef void (*GEMMKernelFunc)( int kc, const float* a, const float* b, float* d, size_t d_step );
+
+class GEMMPacked_32f_Invoker : public ParallelLoopBody
+{
+public:
+    GEMMPacked_32f_Invoker( const float* _a, size_t _a_step0, size_t _a_step1,
+                            const float* _b, size_t _b_step0, size_t _b_step1,
+                            const float* _c, size_t _c_step0, size_t _c_step1,
+                            float* _d, size_t _d_step, Size _d_size, int _len,
+                            double _alpha, double _beta, GEMMKernelFunc _kernel ) :
+        a(_a), a_step0(_a_step0), a_step1(_a_step1),
+        b(_b), b_step0(_b_step0), b_step1(_b_step1),
+        c(_c), c_step0(_c_step0), c_step1(_c_step1),
+        d(_d), d_step(_d_step), d_size(_d_size), len(_len),
+        alpha(_alpha), beta(_beta), kernel(_kernel)
+    {
+        ntiles_n = (d_size.width + GEMM_NC - 1)/GEMM_NC;
+    }
+
+    void operator()( const Range& range ) const
+    {
+        AutoBuffer<float> _buf(GEMM_MC*GEMM_KC + GEMM_KC*GEMM_NC + GEMM_MC*GEMM_NC + 8);
+        float* a_buf = alignPtr((float*)_buf, 32);
+        float* b_buf = a_buf + GEMM_MC*GEMM_KC;
+        float* acc = b_buf + GEMM_KC*GEMM_NC;
+
+        for( int t = range.start; t < range.end; t++ )
+        {
+            int i0 = (t / ntiles_n)*GEMM_MC, j0 = (t % ntiles_n)*GEMM_NC;
+            int mc = std::min( d_size.height - i0, (int)GEMM_MC );
+            int nc = std::min( d_size.width - j0, (int)GEMM_NC );
+            // The accumulator covers whole register tiles, so the kernel never needs edge handling;
+            // the zero padding of the packed panels only lands in the unused rows and columns.
+            size_t acc_step = (nc + GEMM_NR - 1)/GEMM_NR*GEMM_NR;
+            int i, j, k0;
+
+            memset( acc, 0, (mc + GEMM_MR - 1)/GEMM_MR*GEMM_MR*acc_step*sizeof(acc[0]) );
+
+            for( k0 = 0; k0 < len; k0 += GEMM_KC )
+            {
+                int kc = std::min( len - k0, (int)GEMM_KC );
+                GEMMPackA_32f( a + i0*a_step0 + k0*a_step1, a_step0, a_step1, mc, kc, a_buf );
+                GEMMPackB_32f( b + k0*b_step0 + j0*b_step1, b_step0, b_step1, kc, nc, b_buf );
+
+                for( j = 0; j < nc; j += GEMM_NR )
+                    for( i = 0; i < mc; i += GEMM_MR )
+                        kernel( kc, a_buf + i*kc, b_buf + j*kc, acc + i*acc_step + j, acc_step );
+            }
+
+            for( i = 0; i < mc; i++ )
+            {
+                const float* acc_i = acc + i*acc_step;
+                float* d_i = d + (i0 + i)*d_step + j0;
+
+                if( c )
+                {
+                    const float* c_i = c + (i0 + i)*c_step0 + j0*c_step1;
+                    for( j = 0; j < nc; j++ )
+                        d_i[j] = (float)(alpha*acc_i[j] + beta*c_i[j*c_step1]);
+                }
+                else
+                    for( j = 0; j < nc; j++ )
+                        d_i[j] = (float)(alpha*acc_i[j]);
+            }
+        }
+    }
+
+private:
+    const float* a;
+    size_t a_step0, a_step1;
+    const float* b;
+    size_t b_step0, b_step1;
+    const float* c;
+    size_t c_step0, c_step1;
+    float* d;
+    size_t d_step;
+    Size d_size;
+    int len, ntiles_n;
+    double alpha, beta;
+    GEMMKernelFunc kernel;
+};
+
+#endif
+
+// Runs D = alpha*op(A)*op(B) + beta*op(C) for CV_32FC1 through the packed kernel.
+// Returns false when there is no SIMD kernel for this CPU or the product is too small to pay
+// for the packing; the caller then falls back to GEMMSingleMul/GEMMBlockMul.
+static bool
+gemmPacked_32f( const Mat& A, const Mat& B, double alpha, const Mat& C, double beta,
+                Mat& D, Size d_size, int len, int flags )
+{
+#if CV_SSE2
+    GEMMKernelFunc kernel = 0;
+#if CV_AVX2
+    if( USE_AVX2 && (!CV_FMA3 || checkHardwareSupport(CV_CPU_FMA3)) )
+        kernel = GEMMKernel_32f_AVX2;
+#endif
+    if( !kernel && USE_SSE2 )
+        kernel = GEMMKernel_32f_SSE2;
+
+    if( !kernel || d_size.width < GEMM_NR || d_size.height < GEMM_MR || len < 16 ||
+        (double)d_size.width*d_size.height*len < 32.*32.*32. )
+        return false;
+
+    size_t a_step = A.step/sizeof(float), b_step = B.step/sizeof(float);
+    size_t a_step0 = a_step, a_step1 = 1, b_step0 = b_step, b_step1 = 1;
+    size_t c_step0 = 0, c_step1 = 0;
+
+    if( flags & GEMM_1_T )
+        std::swap( a_step0, a_step1 );
+    if( flags & GEMM_2_T )
+        std::swap( b_step0, b_step1 );
+    if( !C.empty() )
+    {
+        c_step0 = C.step/sizeof(float), c_step1 = 1;
+        if( flags & GEMM_3_T )
+            std::swap( c_step0, c_step1 );
+    }
+
+    // tiles read A and B while other tiles are already being written
+    Mat tmat;
+    Mat& dst = D.data == A.data || D.data == B.data ? tmat : D;
+    if( &dst == &tmat )
+        tmat.create( d_size, CV_32F );
+
+    int ntiles = ((d_size.height + GEMM_MC - 1)/GEMM_MC)*((d_size.width + GEMM_NC - 1)/GEMM_NC);
+    GEMMPacked_32f_Invoker invoker( A.ptr<float>(), a_step0, a_step1,
+                                    B.ptr<float>(), b_step0, b_step1,
+                                    C.empty() ? 0 : C.ptr<float>(), c_step0, c_step1,
+                                    dst.ptr<float>(), dst.step/sizeof(float), d_size, len,
+                                    alpha, C.empty() ? 0. : beta, kernel );
+    parallel_for_( Range(0, ntiles), invoker );
+
+    if( &dst == &tmat )
+        tmat.copyTo( D );
+    return true;
+#else
+    (void)A; (void)B; (void)alpha; (void)C; (void)beta;
+    (void)D; (void)d_size; (void)len; (void)flags;
+    return false;
+#endif
+}
+
 #ifdef HAVE_CLAMDBLAS
 
 static bool ocl_gemm_amdblas( InputArray matA, InputArray matB, double alpha,
@@ -1189,6 +1510,9 @@ void cv::gemm( InputArray matA, InputArray matB, double alpha,
         }
     }
 
+    if( type == CV_32FC1 && gemmPacked_32f( A, B, alpha, C, beta, D, d_size, len, flags ) )
+        return;
+
     {
     size_t b_step = B.step;
     GEMMSingleMulFunc singleMulFunc;
@@ -3417,6 +3417,38 @@ reduceC_( const Mat& srcmat, Mat& dstmat )
 
 typedef void (*ReduceFunc)( const Mat& src, Mat& dst );
 
+// large arrays are reduced in parallel over stripes of about REDUCE_STRIPE_SIZE elements,
+// each of them covering at least REDUCE_MIN_LINES output elements
+enum { REDUCE_STRIPE_SIZE = 1 << 16, REDUCE_MIN_LINES = 16 };
+
+class ReduceInvoker : public ParallelLoopBody
+{
+public:
+    ReduceInvoker( const Mat& _src, Mat& _dst, ReduceFunc _func, int _dim, int _nstripes )
+        : src(_src), dst(_dst), func(_func), dim(_dim), nstripes(_nstripes) {}
+
+    void operator()( const Range& range ) const
+    {
+        int lines = dim == 0 ? src.cols : src.rows;
+        int start = (int)((int64)lines*range.start/nstripes), end = (int)((int64)lines*range.end/nstripes);
+        if( dim == 0 )
+        {
+            Mat dstStripe = dst.colRange(start, end);
+            func( src.colRange(start, end), dstStripe );
+        }
+        else
+        {
+            Mat dstStripe = dst.rowRange(start, end);
+            func( src.rowRange(start, end), dstStripe );
+        }
+    }
+
+protected:
+    Mat src, dst;
+    ReduceFunc func;
+    int dim, nstripes;
+};
+
 }
 
 #define reduceSumR8u32s  reduceR_<uchar, int,   OpAdd<int> >
@@ -3835,7 +3867,13 @@ void cv::reduce(InputArray _src, OutputArray _dst, int dim, int op, int dtype)
         CV_Error( CV_StsUnsupportedFormat,
                   "Unsupported combination of input and output array formats" );
 
-    func( src, temp );
+    // the output elements do not depend on each other, so the result is the same with any split
+    int lines = dim == 0 ? src.cols : src.rows;
+    int nstripes = (int)std::min( src.total()*cn/REDUCE_STRIPE_SIZE, (size_t)(lines/REDUCE_MIN_LINES) );
+    if( nstripes > 1 )
+        parallel_for_( Range(0, nstripes), ReduceInvoker(src, temp, func, dim, nstripes) );
+    else
+        func( src, temp );
 
     if( op0 == CV_REDUCE_AVG )
         temp.convertTo(dst, dst.type(), 1./(dim == 0 ? src.rows : src.cols));
@@ -50,7 +50,7 @@
 namespace cv
 {
 
-PCA::PCA() {}
+PCA::PCA() : samples(0) {}
 
 PCA::PCA(InputArray data, InputArray _mean, int flags, int maxComponents)
 {
@@ -62,6 +62,63 @@ PCA::PCA(InputArray data, InputArray _mean, int flags, double retainedVariance)
     operator()(data, _mean, flags, retainedVariance);
 }
 
+// Orthonormalizes the rows of q in place (modified Gram-Schmidt, two passes for stability).
+// Rows that are numerically dependent on the previous ones are zeroed.
+static void orthonormalizeRows( Mat& q )
+{
+    double eps = q.depth() == CV_32F ? FLT_EPSILON*16 : DBL_EPSILON*16;
+    for( int pass = 0; pass < 2; pass++ )
+        for( int i = 0; i < q.rows; i++ )
+        {
+            Mat qi = q.row(i);
+            double nrm0 = norm(qi);
+            for( int j = 0; j < i; j++ )
+            {
+                Mat qj = q.row(j);
+                scaleAdd( qj, -qj.dot(qi), qi, qi );
+            }
+            double nrm = norm(qi);
+            if( nrm > nrm0*eps )
+                qi *= 1./nrm;
+            else
+                qi = Scalar::all(0);
+        }
+}
+
+// Leading principal components of the centered samples x (one sample per row) found with
+// a Gaussian range finder refined by power iterations (Halko, Martinsson & Tropp, 2011).
+// Only l = k + oversampling vectors are kept, so no len x len matrix is ever formed.
+// The eigenvalues are the squared singular values of x times scale.
+enum { PCA_OVERSAMPLING = 10, PCA_POWER_ITERATIONS = 3 };
+
+static void randomizedComponents( const Mat& x, int k, double scale,
+                                  Mat& eigenvalues, Mat& eigenvectors )
+{
+    int l = std::min(k + PCA_OVERSAMPLING, std::min(x.rows, x.cols));
+    Mat omega(l, x.cols, x.type()), y, z;
+
+    theRNG().fill(omega, RNG::NORMAL, 0, 1);
+    gemm( omega, x, 1, Mat(), 0, y, GEMM_2_T );
+    orthonormalizeRows( y );
+
+    for( int iter = 0; iter < PCA_POWER_ITERATIONS; iter++ )
+    {
+        gemm( y, x, 1, Mat(), 0, z );
+        orthonormalizeRows( z );
+        gemm( z, x, 1, Mat(), 0, y, GEMM_2_T );
+        orthonormalizeRows( y );
+    }
+
+    // project the samples onto the found range and decompose the small l x len matrix
+    Mat w, u, vt;
+    gemm( y, x, 1, Mat(), 0, z );
+    SVD::compute( z, w, u, vt );
+
+    k = std::min(k, w.rows);
+    multiply( w.rowRange(0, k), w.rowRange(0, k), eigenvalues, scale );
+    eigenvectors = vt.rowRange(0, k).clone();
+}
+
 PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComponents)
 {
     Mat data = _data.getMat(), _mean = __mean.getMat();
@@ -88,13 +145,42 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComp
     int count = std::min(len, in_count), out_count = count;
     if( maxComponents > 0 )
         out_count = std::min(count, maxComponents);
+    samples = in_count;
+
+    int ctype = std::max(CV_32F, data.depth());
+
+    if( flags & PCA::RANDOMIZED )
+    {
+        CV_Assert( maxComponents > 0 );
+
+        Mat tmp_data, row_mean;
+        if( flags & CV_PCA_DATA_AS_COL )
+            transpose( data, tmp_data );
+        else
+            tmp_data = data;
+        tmp_data.convertTo( tmp_data, ctype );
+        if( tmp_data.data == data.data )
+            tmp_data = tmp_data.clone();
+
+        if( !_mean.empty() )
+        {
+            CV_Assert( _mean.size() == mean_sz );
+            _mean.reshape(1, 1).convertTo( row_mean, ctype );
+        }
+        else
+            reduce( tmp_data, row_mean, 0, CV_REDUCE_AVG, ctype );
+        subtract( tmp_data, repeat(row_mean, tmp_data.rows, 1), tmp_data );
+
+        randomizedComponents( tmp_data, out_count, 1./tmp_data.rows, eigenvalues, eigenvectors );
+        row_mean.reshape(1, mean_sz.height).copyTo( mean );
+        return *this;
+    }
 
     // "scrambled" way to compute PCA (when cols(A)>rows(A)):
     // B = A'A; B*x=b*x; C = AA'; C*y=c*y -> AA'*y=c*y -> A'A*(A'*y)=c*(A'*y) -> c = b, x=A'*y
     if( len <= in_count )
         covar_flags |= CV_COVAR_NORMAL;
 
-    int ctype = std::max(CV_32F, data.depth());
     mean.create( mean_sz, ctype );
 
     Mat covar( count, count, ctype );
@@ -156,6 +242,7 @@ void PCA::write(FileStorage& fs ) const
     fs << "vectors" << eigenvectors;
     fs << "values" << eigenvalues;
     fs << "mean" << mean;
+    fs << "samples" << (double)samples;
 }
 
 void PCA::read(const FileNode& fs)
@@ -167,6 +254,103 @@ void PCA::read(const FileNode& fs)
     cv::read(fs["vectors"], eigenvectors);
     cv::read(fs["values"], eigenvalues);
     cv::read(fs["mean"], mean);
+    FileNode samples_node = fs["samples"];
+    samples = samples_node.empty() ? 0 : (int64)(double)samples_node;
+}
+
+PCA& PCA::update(InputArray _data, int flags, int maxComponents)
+{
+    Mat data = _data.getMat(), batch;
+    CV_Assert( data.channels() == 1 );
+    if( data.empty() )
+        return *this;
+
+    bool as_col = (flags & CV_PCA_DATA_AS_COL) != 0;
+    if( as_col )
+        transpose( data, batch );
+    else
+        batch = data;
+
+    int len = batch.cols, count = batch.rows, k = 0;
+    int ctype = mean.empty() ? std::max(CV_32F, data.depth()) : mean.type();
+    Mat old_mean, lambda;
+
+    if( !mean.empty() )
+    {
+        CV_Assert( samples > 0 && (int)mean.total() == len &&
+                   (as_col ? mean.cols == 1 : mean.rows == 1) &&
+                   eigenvectors.cols == len && eigenvectors.type() == ctype &&
+                   (int)eigenvalues.total() == eigenvectors.rows );
+        k = eigenvectors.rows;
+        old_mean = mean.reshape(1, 1);
+        eigenvalues.convertTo( lambda, CV_64F );
+    }
+    else
+    {
+        samples = 0;
+        old_mean = Mat::zeros(1, len, ctype);
+    }
+
+    Mat batch_mean, centered;
+    batch.convertTo( centered, ctype );
+    if( centered.data == data.data )
+        centered = centered.clone();
+    reduce( centered, batch_mean, 0, CV_REDUCE_AVG, ctype );
+    subtract( centered, repeat(batch_mean, count, 1), centered );
+
+    // The scatter matrix of all the samples is the scatter of the old ones, which the current
+    // model keeps as n0*V'*diag(lambda)*V, plus the scatter of the batch, plus a rank-one term
+    // for the shift between the two means. Stack the square roots of the three parts as the
+    // rows of a, so that the scatter is a'*a.
+    double n0 = (double)samples, n1 = count, n = n0 + n1;
+    Mat a(k + count + 1, len, ctype);
+    for( int i = 0; i < k; i++ )
+    {
+        Mat row = a.row(i);
+        eigenvectors.row(i).convertTo( row, ctype, std::sqrt(n0*std::max(lambda.at<double>(i), 0.)) );
+    }
+    centered.copyTo( a.rowRange(k, k + count) );
+    Mat shift = a.row(k + count);
+    subtract( old_mean, batch_mean, shift );
+    shift *= std::sqrt(n0*n1/n);
+
+    int out_count = maxComponents > 0 ? maxComponents : k > 0 ? k : std::min(len, count);
+    out_count = std::min(out_count, std::min(len, a.rows));
+
+    if( (out_count + PCA_OVERSAMPLING)*2 <= std::min(len, a.rows) )
+    {
+        // only a few components are kept; a full eigen decomposition would dominate the update
+        randomizedComponents( a, out_count, 1./n, eigenvalues, eigenvectors );
+    }
+    else
+    {
+        // same "scrambled" trick as in operator(): with fewer rows than columns decompose a*a'
+        // and map its eigenvectors back through a
+        Mat scatter, evals, evects;
+        mulTransposed( a, scatter, a.rows >= len );
+        eigen( scatter, evals, evects );
+        if( a.rows < len )
+        {
+            Mat evects1;
+            gemm( evects.rowRange(0, out_count), a, 1, Mat(), 0, evects1 );
+            for( int i = 0; i < out_count; i++ )
+            {
+                Mat vec = evects1.row(i);
+                normalize(vec, vec);
+            }
+            eigenvectors = evects1;
+        }
+        else
+            eigenvectors = evects.rowRange(0, out_count).clone();
+        max( evals.rowRange(0, out_count), Scalar::all(0), eigenvalues );
+        eigenvalues *= 1./n;
+    }
+
+    Mat new_mean;
+    addWeighted( old_mean, n0/n, batch_mean, n1/n, 0, new_mean, ctype );
+    mean = as_col ? new_mean.reshape(1, len) : new_mean;
+    samples += count;
+    return *this;
 }
 
 template <typename T>
@@ -225,6 +409,7 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, double reta
     CV_Assert( retainedVariance > 0 && retainedVariance <= 1 );
 
     int count = std::min(len, in_count);
+    samples = in_count;
 
     // "scrambled" way to compute PCA (when cols(A)>rows(A)):
     // B = A'A; B*x=b*x; C = AA'; C*y=c*y -> AA'*y=c*y -> A'A*(A'*y)=c*(A'*y) -> c = b, x=A'*y
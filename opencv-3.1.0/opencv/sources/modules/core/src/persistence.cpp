@@ -67,6 +67,19 @@
 #  include <zlib.h>
 #endif
 
+#if defined WIN32 || defined _WIN32
+#  include <windows.h>
+#  undef small
+#  undef min
+#  undef max
+#  undef abs
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
 /****************************************************************************************\
 *                            Common macros and type definitions                          *
 \****************************************************************************************/
@@ -172,6 +185,16 @@ typedef struct CvFileMapNode
 }
 CvFileMapNode;
 
+/* read-only (copy-on-write) mapping of a binary sidecar file, shared by the storage
+   and all the matrices that point into it */
+typedef struct CvFileSidecar
+{
+    int refcount;
+    uchar* data;
+    size_t size;
+}
+CvFileSidecar;
+
 typedef struct CvXMLStackRecord
 {
     CvMemStoragePos pos;
@@ -239,6 +262,11 @@ typedef struct CvFileStorage
     std::deque<char>* outbuf;
 
     bool is_opened;
+
+    FILE* sidecar;
+    int64 sidecar_size;
+    CvFileSidecar* sidecar_map;
+    bool verify_sidecar;
 }
 CvFileStorage;
 
@@ -325,6 +353,184 @@ static void icvRewind( CvFileStorage* fs )
     fs->strbufpos = 0;
 }
 
+/****************************************************************************************\
+*                                  Binary sidecar files                                  *
+\****************************************************************************************/
+
+// matrices smaller than that are still written as text
+#define CV_FS_SIDECAR_MIN_SIZE  4096
+// every matrix starts at a multiple of this offset in the sidecar
+#define CV_FS_SIDECAR_ALIGN     64
+
+static cv::String icvSidecarName( const CvFileStorage* fs )
+{
+    return cv::String(fs->filename) + ".raw";
+}
+
+static unsigned icvSidecarCRC( unsigned crc, const uchar* data, size_t size )
+{
+#if USE_ZLIB
+    // crc32() takes the length as uInt
+    const size_t max_chunk = (size_t)1 << 30;
+    for( ; size > 0; )
+    {
+        size_t chunk = std::min(size, max_chunk);
+        crc = (unsigned)crc32( crc, data, (uInt)chunk );
+        data += chunk;
+        size -= chunk;
+    }
+#else
+    (void)data; (void)size;
+#endif
+    return crc;
+}
+
+static void icvReleaseSidecar( CvFileSidecar** p_sidecar )
+{
+    CvFileSidecar* sidecar = *p_sidecar;
+    *p_sidecar = 0;
+    if( !sidecar || CV_XADD(&sidecar->refcount, -1) != 1 )
+        return;
+#if defined WIN32 || defined _WIN32
+    UnmapViewOfFile( sidecar->data );
+#else
+    munmap( sidecar->data, sidecar->size );
+#endif
+    cvFree( &sidecar );
+}
+
+// Maps the sidecar of a storage opened for reading on first use. The mapping is private,
+// so matrices that point into it can be modified without touching the file.
+static CvFileSidecar* icvMapSidecar( CvFileStorage* fs )
+{
+    if( fs->sidecar_map )
+        return fs->sidecar_map;
+    if( !fs->filename )
+        CV_Error( CV_StsNotImplemented, "Matrices stored in a binary sidecar can only be read from a file" );
+
+    cv::String name = icvSidecarName(fs);
+    void* data = 0;
+    size_t size = 0;
+#if defined WIN32 || defined _WIN32
+    HANDLE file = CreateFileA( name.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+    if( file != INVALID_HANDLE_VALUE )
+    {
+        LARGE_INTEGER file_size;
+        if( GetFileSizeEx( file, &file_size ) && file_size.QuadPart > 0 &&
+            (unsigned long long)file_size.QuadPart <= (unsigned long long)(size_t)-1 )
+        {
+            HANDLE mapping = CreateFileMappingA( file, 0, PAGE_WRITECOPY, 0, 0, 0 );
+            if( mapping )
+            {
+                // the view keeps the mapping alive
+                data = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+                size = (size_t)file_size.QuadPart;
+                CloseHandle( mapping );
+            }
+        }
+        CloseHandle( file );
+    }
+#else
+    int fd = open( name.c_str(), O_RDONLY );
+    if( fd >= 0 )
+    {
+        struct stat st;
+        if( fstat( fd, &st ) == 0 && st.st_size > 0 )
+        {
+            size = (size_t)st.st_size;
+            data = mmap( 0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+            if( data == MAP_FAILED )
+                data = 0;
+        }
+        close( fd );
+    }
+#endif
+    if( !data )
+        CV_Error_( CV_StsError, ("Could not map the sidecar file %s", name.c_str()) );
+
+    CvFileSidecar* sidecar = (CvFileSidecar*)cvAlloc( sizeof(*sidecar) );
+    sidecar->refcount = 1;
+    sidecar->data = (uchar*)data;
+    sidecar->size = size;
+    fs->sidecar_map = sidecar;
+    return sidecar;
+}
+
+/* Appends raw matrix data (rows of row_size bytes, step bytes apart) to the sidecar
+   and writes a reference to it into the current map. Returns false without writing
+   anything if the storage has no sidecar or the matrix is small enough for text. */
+static bool
+icvWriteSidecarData( CvFileStorage* fs, const uchar* data, size_t step, int rows, size_t row_size )
+{
+    size_t total = row_size*rows;
+    if( !fs->sidecar || total < CV_FS_SIDECAR_MIN_SIZE )
+        return false;
+
+    static const uchar zeros[CV_FS_SIDECAR_ALIGN] = {0};
+    int64 offset = (fs->sidecar_size + CV_FS_SIDECAR_ALIGN - 1) & -(int64)CV_FS_SIDECAR_ALIGN;
+    size_t pad = (size_t)(offset - fs->sidecar_size);
+    bool ok = fwrite( zeros, 1, pad, fs->sidecar ) == pad;
+
+    unsigned crc = 0;
+    if( step == row_size )
+        row_size = total, rows = 1;
+    for( int y = 0; y < rows && ok; y++ )
+    {
+        const uchar* row = data + step*y;
+        ok = fwrite( row, 1, row_size, fs->sidecar ) == row_size;
+        crc = icvSidecarCRC( crc, row, row_size );
+    }
+    if( !ok )
+        CV_Error( CV_StsError, "Could not write the matrix data to the sidecar file" );
+    fs->sidecar_size = offset + (int64)total;
+
+    char buf[32];
+    // quoted: a plain number could exceed the range of integer nodes
+    sprintf( buf, "%lld", (long long)offset );
+    cvWriteString( fs, "raw_offset", buf, 1 );
+#if USE_ZLIB
+    sprintf( buf, "%08x", crc );
+    cvWriteString( fs, "raw_crc32", buf, 1 );
+#endif
+    return true;
+}
+
+/* Returns the data of a matrix referenced from node and stored in the sidecar,
+   after checking that it lies inside the file and, if requested, its checksum.
+   The mapping is kept alive until the caller releases the returned reference. */
+static const uchar*
+icvReadSidecarData( CvFileStorage* fs, CvFileNode* node, size_t size, CvFileSidecar** p_sidecar )
+{
+    const char* offset_str = cvReadStringByName( fs, node, "raw_offset", 0 );
+    if( !offset_str )
+        CV_Error( CV_StsError, "The matrix data is not found in file storage" );
+
+    uint64 offset = 0;
+    const char* ptr = offset_str;
+    for( ; cv_isdigit(*ptr) && offset <= ((uint64)-1 - 9)/10; ptr++ )
+        offset = offset*10 + (*ptr - '0');
+    if( ptr == offset_str || *ptr != '\0' )
+        CV_Error( CV_StsParseError, "Invalid sidecar offset" );
+
+    CvFileSidecar* sidecar = icvMapSidecar( fs );
+    if( offset > sidecar->size || size > sidecar->size - offset )
+        CV_Error( CV_StsOutOfRange, "The matrix data lies outside of the sidecar file" );
+    const uchar* data = sidecar->data + offset;
+
+    const char* crc_str = cvReadStringByName( fs, node, "raw_crc32", 0 );
+    if( fs->verify_sidecar && crc_str )
+    {
+        unsigned crc = (unsigned)strtoul( crc_str, 0, 16 );
+        if( icvSidecarCRC( 0, data, size ) != crc )
+            CV_Error( CV_StsParseError, "The checksum of the matrix data in the sidecar file does not match" );
+    }
+
+    CV_XADD( &sidecar->refcount, 1 );
+    *p_sidecar = sidecar;
+    return data;
+}
+
 #define CV_YML_INDENT  3
 #define CV_XML_INDENT  2
 #define CV_YML_INDENT_FLOW  1
@@ -535,6 +741,12 @@ icvClose( CvFileStorage* fs, cv::String* out )
         icvCloseFile(fs);
     }
 
+    if( fs->sidecar )
+    {
+        fclose( fs->sidecar );
+        fs->sidecar = 0;
+    }
+
     if( fs->outbuf && out )
     {
         *out = cv::String(fs->outbuf->begin(), fs->outbuf->end());
@@ -555,6 +767,7 @@ cvReleaseFileStorage( CvFileStorage** p_fs )
         *p_fs = 0;
 
         icvClose(fs, 0);
+        icvReleaseSidecar( &fs->sidecar_map );
 
         cvReleaseMemStorage( &fs->strstorage );
         cvFree( &fs->buffer_start );
@@ -2721,6 +2934,28 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
         }
     }
 
+    if( !mem && write_mode && (flags & CV_STORAGE_BINARY_SIDECAR) )
+    {
+        cv::String sidecar_name = icvSidecarName(fs);
+        fs->sidecar = fopen( sidecar_name.c_str(), append ? "ab" : "wb" );
+        if( !fs->sidecar )
+        {
+            icvCloseFile( fs );
+            goto _exit_;
+        }
+        if( append )
+        {
+#if defined WIN32 || defined _WIN32
+            _fseeki64( fs->sidecar, 0, SEEK_END );
+            fs->sidecar_size = _ftelli64( fs->sidecar );
+#else
+            fseeko( fs->sidecar, 0, SEEK_END );
+            fs->sidecar_size = (int64)ftello( fs->sidecar );
+#endif
+        }
+    }
+    fs->verify_sidecar = (flags & CV_STORAGE_VERIFY_SIDECAR) != 0;
+
     fs->roots = 0;
     fs->struct_indent = 0;
     fs->struct_flags = 0;
@@ -3511,9 +3746,16 @@ icvWriteMat( CvFileStorage* fs, const char* name,
     cvWriteInt( fs, "rows", mat->rows );
     cvWriteInt( fs, "cols", mat->cols );
     cvWriteString( fs, "dt", icvEncodeFormat( CV_MAT_TYPE(mat->type), dt ), 0 );
-    cvStartWriteStruct( fs, "data", CV_NODE_SEQ + CV_NODE_FLOW );
 
     size = cvGetSize(mat);
+    if( mat->data.ptr && icvWriteSidecarData( fs, mat->data.ptr, mat->step, size.height,
+                                              (size_t)size.width*CV_ELEM_SIZE(mat->type) ) )
+    {
+        cvEndWriteStruct( fs );
+        return;
+    }
+
+    cvStartWriteStruct( fs, "data", CV_NODE_SEQ + CV_NODE_FLOW );
     if( size.height > 0 && size.width > 0 && mat->data.ptr )
     {
         if( CV_IS_MAT_CONT(mat->type) )
@@ -3558,7 +3800,15 @@ icvReadMat( CvFileStorage* fs, CvFileNode* node )
 
     data = cvGetFileNodeByName( fs, node, "data" );
     if( !data )
-        CV_Error( CV_StsError, "The matrix data is not found in file storage" );
+    {
+        CvFileSidecar* sidecar = 0;
+        size_t size = (size_t)rows*cols*CV_ELEM_SIZE(elem_type);
+        const uchar* src = icvReadSidecarData( fs, node, size, &sidecar );
+        mat = cvCreateMat( rows, cols, elem_type );
+        memcpy( mat->data.ptr, src, size );
+        icvReleaseSidecar( &sidecar );
+        return mat;
+    }
 
     int nelems = icvFileNodeSeqLen( data );
     if( nelems > 0 && nelems != rows*cols*CV_MAT_CN(elem_type) )
@@ -3607,8 +3857,15 @@ icvWriteMatND( CvFileStorage* fs, const char* name,
     cvWriteRawData( fs, sizes, dims, "i" );
     cvEndWriteStruct( fs );
     cvWriteString( fs, "dt", icvEncodeFormat( cvGetElemType(mat), dt ), 0 );
-    cvStartWriteStruct( fs, "data", CV_NODE_SEQ + CV_NODE_FLOW );
 
+    if( mat->data.ptr && CV_IS_MAT_CONT(mat->type) &&
+        icvWriteSidecarData( fs, mat->data.ptr, 0, 1, (size_t)mat->dim[0].size*mat->dim[0].step ) )
+    {
+        cvEndWriteStruct( fs );
+        return;
+    }
+
+    cvStartWriteStruct( fs, "data", CV_NODE_SEQ + CV_NODE_FLOW );
     if( mat->dim[0].size > 0 && mat->data.ptr )
     {
         cvInitNArrayIterator( 1, (CvArr**)&mat, 0, &stub, &iterator );
@@ -3650,9 +3907,17 @@ icvReadMatND( CvFileStorage* fs, CvFileNode* node )
 
     data = cvGetFileNodeByName( fs, node, "data" );
     if( !data )
-        CV_Error( CV_StsError, "The matrix data is not found in file storage" );
-
-
+    {
+        CvFileSidecar* sidecar = 0;
+        size_t size = CV_ELEM_SIZE(elem_type);
+        for( i = 0; i < dims; i++ )
+            size *= sizes[i];
+        const uchar* src = icvReadSidecarData( fs, node, size, &sidecar );
+        mat = cvCreateMatND( dims, sizes, elem_type );
+        memcpy( mat->data.ptr, src, size );
+        icvReleaseSidecar( &sidecar );
+        return mat;
+    }
 
     for( total_size = CV_MAT_CN(elem_type), i = 0; i < dims; i++ )
         total_size *= sizes[i];
@@ -5526,6 +5791,85 @@ internal::WriteStructContext::~WriteStructContext()
 }
 
 
+// Keeps the sidecar mapping alive while matrices point into it
+class SidecarAllocator : public MatAllocator
+{
+public:
+    SidecarAllocator() { stdAllocator = Mat::getStdAllocator(); }
+
+    UMatData* allocate(int dims, const int* sizes, int type, void* data,
+                       size_t* step, int flags, UMatUsageFlags usageFlags) const
+    {
+        return stdAllocator->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, int accessFlags, UMatUsageFlags usageFlags) const
+    {
+        return stdAllocator->allocate(u, accessFlags, usageFlags);
+    }
+
+    void deallocate(UMatData* u) const
+    {
+        if( !u )
+            return;
+        CV_Assert( u->urefcount >= 0 && u->refcount >= 0 );
+        if( u->refcount == 0 )
+        {
+            CvFileSidecar* sidecar = (CvFileSidecar*)u->userdata;
+            icvReleaseSidecar( &sidecar );
+            delete u;
+        }
+    }
+
+    const MatAllocator* stdAllocator;
+};
+
+static SidecarAllocator& getSidecarAllocator()
+{
+    CV_SINGLETON_LAZY_INIT_REF(SidecarAllocator, new SidecarAllocator())
+}
+
+// makes mat a header over the sidecar data of a matrix written with FileStorage::BINARY_SIDECAR
+static void readSidecarMat( const FileNode& node, Mat& mat )
+{
+    int dims, sizes[CV_MAX_DIM];
+    FileNode sizes_node = node["sizes"];
+    if( sizes_node.empty() )
+    {
+        dims = 2;
+        sizes[0] = (int)node["rows"];
+        sizes[1] = (int)node["cols"];
+    }
+    else
+    {
+        std::vector<int> sz;
+        sizes_node >> sz;
+        dims = (int)sz.size();
+        CV_Assert( 0 < dims && dims <= CV_MAX_DIM );
+        std::copy(sz.begin(), sz.end(), sizes);
+    }
+    int type = icvDecodeSimpleFormat( ((String)node["dt"]).c_str() );
+
+    size_t size = CV_ELEM_SIZE(type);
+    for( int i = 0; i < dims; i++ )
+    {
+        CV_Assert( sizes[i] >= 0 );
+        size *= sizes[i];
+    }
+
+    CvFileSidecar* sidecar = 0;
+    uchar* data = (uchar*)icvReadSidecarData( (CvFileStorage*)node.fs, (CvFileNode*)*node, size, &sidecar );
+
+    Mat m(dims, sizes, type, data);
+    UMatData* u = new UMatData(&getSidecarAllocator());
+    u->data = u->origdata = data;
+    u->size = size;
+    u->refcount = 1;
+    u->userdata = sidecar;
+    m.u = u;
+    mat = m;
+}
+
 void read( const FileNode& node, Mat& mat, const Mat& default_mat )
 {
     if( node.empty() )
@@ -5533,6 +5877,11 @@ void read( const FileNode& node, Mat& mat, const Mat& default_mat )
         default_mat.copyTo(mat);
         return;
     }
+    if( node.isMap() && !node["raw_offset"].empty() )
+    {
+        readSidecarMat(node, mat);
+        return;
+    }
     void* obj = cvRead((CvFileStorage*)node.fs, (CvFileNode*)*node);
     if(CV_IS_MAT_HDR_Z(obj))
     {
@@ -5661,4 +6010,1037 @@ void read(const FileNode& node, String& value, const String& default_value)
 
 }
 
+/****************************************************************************************\
+*                                  Streaming reader                                      *
+\****************************************************************************************/
+
+namespace cv
+{
+
+// Parses a number the way FileStorage writes it, including .Inf, -.Inf and .Nan.
+// The text must be writable, see icv_strtod().
+static double icvReaderStrtod( char* ptr, char** endptr )
+{
+    char* p = ptr + (*ptr == '-' || *ptr == '+');
+    if( p[0] == '.' && cv_isalpha(p[1]) && cv_isalpha(p[2]) && cv_isalpha(p[3]) && !cv_isalnum(p[4]) )
+    {
+        char lower[3];
+        for( int i = 0; i < 3; i++ )
+            lower[i] = (char)tolower( p[i+1] );
+        if( memcmp( lower, "inf", 3 ) == 0 || memcmp( lower, "nan", 3 ) == 0 )
+        {
+            *endptr = p + 4;
+            return lower[0] == 'n' ? std::numeric_limits<double>::quiet_NaN() :
+                   *ptr == '-' ? -std::numeric_limits<double>::infinity() :
+                                 std::numeric_limits<double>::infinity();
+        }
+    }
+
+    // strtod() follows the C locale, which may expect ',' instead of '.'
+    double value = strtod( ptr, endptr );
+    if( **endptr == '.' )
+    {
+        char* dot_pos = *endptr;
+        *dot_pos = ',';
+        double value2 = strtod( ptr, endptr );
+        *dot_pos = '.';
+        if( *endptr > dot_pos )
+            value = value2;
+        else
+            *endptr = dot_pos;
+    }
+    return value;
+}
+
+static bool icvReaderParseReal( const std::string& str, double& value )
+{
+    char small_buf[64];
+    std::vector<char> big_buf;
+    char* ptr = small_buf;
+    if( str.size() >= sizeof(small_buf) )
+    {
+        big_buf.resize( str.size() + 1 );
+        ptr = &big_buf[0];
+    }
+    memcpy( ptr, str.c_str(), str.size() + 1 );
+
+    char* endptr = 0;
+    value = icvReaderStrtod( ptr, &endptr );
+    return endptr != ptr && *endptr == '\0';
+}
+
+template<typename _Tp> static void
+icvReaderStore( uchar* data, size_t idx, double value )
+{
+    ((_Tp*)data)[idx] = saturate_cast<_Tp>(value);
+}
+
+typedef void (*ReaderStoreFunc)( uchar* data, size_t idx, double value );
+
+static ReaderStoreFunc getReaderStoreFunc( int depth )
+{
+    static ReaderStoreFunc tab[] =
+    {
+        icvReaderStore<uchar>, icvReaderStore<schar>, icvReaderStore<ushort>, icvReaderStore<short>,
+        icvReaderStore<int>, icvReaderStore<float>, icvReaderStore<double>, 0
+    };
+    return tab[depth];
+}
+
+struct FileStorageReader::Impl
+{
+    struct Event
+    {
+        int type, depth;
+        std::string name, type_name, value;
+    };
+
+    struct Frame
+    {
+        int kind;         // START_MAP or START_SEQ
+        int indent;       // YAML: column of the keys or dashes, -1 in flow collections
+        std::string tag;  // XML: name of the element
+    };
+
+    enum { XML_OPEN = 0, XML_CLOSE = 1, XML_TEXT = 2, XML_EOF = 3 };
+
+    struct XmlToken
+    {
+        int kind;
+        std::string text, type_id;
+    };
+
+    Impl() : file(0), gzfile(0), is_xml(false), lineno(0), ptr(0),
+             pending(false), pending_indent(0)
+    {
+        cur.type = NONE;
+        cur.depth = 0;
+    }
+    ~Impl() { close(); }
+
+    bool open( const String& _filename );
+    void close();
+    bool readLine();
+    void parseError( const char* msg ) const;
+    Event& emit( int type, const std::string& name, const std::string& type_name );
+    void push( int kind, int indent, const std::string& tag );
+    void parse() { if( is_xml ) xmlParse(); else yamlParse(); }
+
+    bool xmlSkipSpaces();
+    void xmlReadToken( XmlToken& t );
+    XmlToken& xmlPeek( size_t i );
+    void xmlParse();
+
+    bool yamlSkipSpaces();
+    void yamlParseString( std::string& str );
+    void yamlParsePlain( std::string& str, bool flow );
+    void yamlParseValue( const std::string& name, const std::string& tag );
+    void yamlParseFlow();
+    void yamlParse();
+    size_t readNumbers( ReaderStoreFunc store, uchar* data, size_t i, size_t n );
+
+    FILE* file;
+    gzFile gzfile;
+    String filename;
+    bool is_xml;
+    int lineno;
+    std::vector<char> buf;
+    char* ptr;
+
+    std::vector<Frame> stack;
+    std::deque<Event> queue;
+    Event cur;
+
+    // XML: tokens read ahead to tell scalars, sequences and maps apart
+    std::deque<XmlToken> tokens;
+    // YAML: a key or a dash whose value starts on one of the next lines
+    bool pending;
+    int pending_indent;
+    std::string pending_name, pending_tag;
+};
+
+bool FileStorageReader::Impl::open( const String& _filename )
+{
+    close();
+    filename = _filename;
+    size_t len = filename.size();
+    bool is_gz = len > 3 && filename.substr(len - 3) == ".gz";
+    if( is_gz )
+    {
+#if USE_ZLIB
+        gzfile = gzopen( filename.c_str(), "rt" );
+#else
+        CV_Error( CV_StsNotImplemented, "There is no compressed file storage support in this configuration" );
+#endif
+    }
+    else
+        file = fopen( filename.c_str(), "rt" );
+    if( !file && !gzfile )
+        return false;
+
+    buf.resize(1 << 12);
+    stack.clear();
+    queue.clear();
+    tokens.clear();
+    pending = false;
+    lineno = 0;
+    cur.type = NONE;
+    cur.depth = 0;
+
+    // the first non-empty line tells the format
+    do
+    {
+        if( !readLine() )
+        {
+            close();
+            CV_Error_( CV_StsParseError, ("%s: the file is empty", filename.c_str()) );
+        }
+        while( cv_isspace(*ptr) )
+            ptr++;
+    }
+    while( *ptr == '\0' );
+
+    is_xml = *ptr == '<';
+    if( is_xml )
+    {
+        XmlToken& t = xmlPeek(0);
+        if( t.kind != XML_OPEN || t.text != "opencv_storage" )
+            parseError( "<opencv_storage> tag is missing" );
+        push( START_MAP, 0, t.text );
+        tokens.pop_front();
+    }
+    else
+        push( START_MAP, 0, std::string() );
+    return true;
+}
+
+void FileStorageReader::Impl::close()
+{
+    if( file )
+        fclose( file );
+    file = 0;
+#if USE_ZLIB
+    if( gzfile )
+        gzclose( gzfile );
+#endif
+    gzfile = 0;
+    ptr = 0;
+}
+
+// Reads the next line, however long, into buf. Returns false at the end of the file.
+bool FileStorageReader::Impl::readLine()
+{
+    size_t len = 0;
+    for(;;)
+    {
+        if( buf.size() - len < 2 )
+            buf.resize( buf.size()*2 );
+        int maxCount = (int)std::min( buf.size() - len, (size_t)INT_MAX );
+        char* line = &buf[len];
+#if USE_ZLIB
+        if( gzfile )
+            line = gzgets( gzfile, line, maxCount );
+        else
+#endif
+            line = fgets( line, maxCount, file );
+        if( !line )
+            break;
+        len += strlen( line );
+        if( len > 0 && buf[len-1] == '\n' )
+            break;
+    }
+    buf[len] = '\0';
+    ptr = &buf[0];
+    lineno++;
+    return len > 0;
+}
+
+void FileStorageReader::Impl::parseError( const char* msg ) const
+{
+    CV_Error_( CV_StsParseError, ("%s(%d): %s", filename.c_str(), lineno, msg) );
+}
+
+FileStorageReader::Impl::Event&
+FileStorageReader::Impl::emit( int type, const std::string& name, const std::string& type_name )
+{
+    queue.push_back( Event() );
+    Event& e = queue.back();
+    e.type = type;
+    e.depth = (int)stack.size() - 1;
+    e.name = name;
+    e.type_name = type_name;
+    return e;
+}
+
+void FileStorageReader::Impl::push( int kind, int indent, const std::string& tag )
+{
+    Frame f;
+    f.kind = kind;
+    f.indent = indent;
+    f.tag = tag;
+    stack.push_back( f );
+}
+
+static void icvReaderDecodeEntity( const char*& ptr, std::string& str )
+{
+    static const char* names[] = { "quot;", "lt;", "gt;", "amp;", "apos;" };
+    static const char chars[] = { '\"', '<', '>', '&', '\'' };
+    ptr++;
+    if( *ptr == '#' )
+    {
+        char* endptr = 0;
+        long val = ptr[1] == 'x' ? strtol( ptr + 2, &endptr, 16 ) : strtol( ptr + 1, &endptr, 10 );
+        if( *endptr == ';' )
+        {
+            str += (char)val;
+            ptr = endptr + 1;
+            return;
+        }
+    }
+    for( int i = 0; i < 5; i++ )
+    {
+        size_t len = strlen( names[i] );
+        if( strncmp( ptr, names[i], len ) == 0 )
+        {
+            str += chars[i];
+            ptr += len;
+            return;
+        }
+    }
+    str += '&';
+}
+
+// Skips spaces, line ends, comments and directives. Returns false at the end of the file.
+bool FileStorageReader::Impl::xmlSkipSpaces()
+{
+    for(;;)
+    {
+        while( cv_isspace(*ptr) )
+            ptr++;
+        if( *ptr == '\0' )
+        {
+            if( !readLine() )
+                return false;
+            continue;
+        }
+        const char* end_mark = ptr[0] != '<' ? 0 :
+            strncmp( ptr, "<!--", 4 ) == 0 ? "-->" : ptr[1] == '?' ? "?>" : 0;
+        if( !end_mark )
+            return true;
+        for( ptr += 2;; )
+        {
+            char* end = strstr( ptr, end_mark );
+            if( end )
+            {
+                ptr = end + strlen(end_mark);
+                break;
+            }
+            if( !readLine() )
+                parseError( "Unterminated comment or directive" );
+        }
+    }
+}
+
+void FileStorageReader::Impl::xmlReadToken( XmlToken& t )
+{
+    t.text.clear();
+    t.type_id.clear();
+    if( !xmlSkipSpaces() )
+    {
+        t.kind = XML_EOF;
+        return;
+    }
+
+    if( *ptr != '<' )
+    {
+        // a literal, possibly quoted
+        t.kind = XML_TEXT;
+        bool is_quoted = *ptr == '\"';
+        const char* p = ptr + is_quoted;
+        for( ;; )
+        {
+            char c = *p;
+            if( c == '\"' && is_quoted )
+            {
+                p++;
+                break;
+            }
+            if( c == '\0' || c == '\n' || c == '\r' || c == '<' || (!is_quoted && cv_isspace(c)) )
+            {
+                if( is_quoted )
+                    parseError( "Closing \" is expected" );
+                break;
+            }
+            if( c == '&' )
+                icvReaderDecodeEntity( p, t.text );
+            else
+                t.text += *p++;
+        }
+        ptr = (char*)p;
+        return;
+    }
+
+    t.kind = ptr[1] == '/' ? XML_CLOSE : XML_OPEN;
+    ptr += 1 + (t.kind == XML_CLOSE);
+    char* name = ptr;
+    while( cv_isalnum(*ptr) || *ptr == '_' || *ptr == '-' || *ptr == ':' || *ptr == '.' )
+        ptr++;
+    if( ptr == name )
+        parseError( "Name should start with a letter or underscore" );
+    t.text.assign( name, ptr );
+
+    for(;;)
+    {
+        while( cv_isspace(*ptr) )
+            ptr++;
+        if( *ptr == '>' )
+        {
+            ptr++;
+            return;
+        }
+        if( *ptr == '/' && ptr[1] == '>' )
+            parseError( "Empty tags are not supported" );
+        if( t.kind == XML_CLOSE )
+            parseError( "Closing tag should not include any attributes" );
+
+        char* attr = ptr;
+        while( cv_isalnum(*ptr) || *ptr == '_' || *ptr == '-' || *ptr == ':' )
+            ptr++;
+        if( ptr == attr || *ptr != '=' || (ptr[1] != '\"' && ptr[1] != '\'') )
+            parseError( "Invalid attribute" );
+        std::string attr_name( attr, ptr );
+        char quote = ptr[1];
+        char* value = ptr + 2;
+        char* end = strchr( value, quote );
+        if( !end )
+            parseError( "Attribute value should be put into single or double quotes" );
+        if( attr_name == "type_id" )
+            t.type_id.assign( value, end );
+        ptr = end + 1;
+    }
+}
+
+FileStorageReader::Impl::XmlToken& FileStorageReader::Impl::xmlPeek( size_t i )
+{
+    while( tokens.size() <= i )
+    {
+        tokens.push_back( XmlToken() );
+        xmlReadToken( tokens.back() );
+    }
+    return tokens[i];
+}
+
+void FileStorageReader::Impl::xmlParse()
+{
+    XmlToken t = xmlPeek(0);
+    tokens.pop_front();
+    const Frame& top = stack.back();
+
+    if( t.kind == XML_EOF )
+        parseError( "Unexpected end of file" );
+
+    if( t.kind == XML_CLOSE )
+    {
+        if( t.text != top.tag )
+            parseError( "Mismatched closing tag" );
+        stack.pop_back();
+        if( stack.empty() )
+            // </opencv_storage>
+            emit( END_OF_STREAM, std::string(), std::string() ).depth = 0;
+        else
+            emit( END, std::string(), std::string() );
+        return;
+    }
+
+    if( t.kind == XML_TEXT )
+    {
+        if( top.kind != START_SEQ )
+            parseError( "Map element should have a name" );
+        emit( SCALAR, std::string(), std::string() ).value.swap( t.text );
+        return;
+    }
+
+    bool is_noname = t.text == "_";
+    if( is_noname != (top.kind == START_SEQ) )
+        parseError( is_noname ? "Map element should have a name" :
+                                "Sequence element should not have name (use <_></_>)" );
+    std::string name;
+    if( !is_noname )
+        name = t.text;
+
+    // the first one or two tokens of the content tell what the element holds
+    const XmlToken& a = xmlPeek(0);
+    int kind = START_SEQ;
+    if( a.kind == XML_OPEN )
+        kind = a.text == "_" ? START_SEQ : START_MAP;
+    else if( a.kind == XML_TEXT )
+    {
+        const XmlToken& b = xmlPeek(1);
+        if( b.kind == XML_CLOSE && b.text == t.text )
+        {
+            emit( SCALAR, name, t.type_id ).value = tokens[0].text;
+            tokens.pop_front();
+            tokens.pop_front();
+            return;
+        }
+    }
+    else if( a.kind == XML_EOF )
+        parseError( "Unexpected end of file" );
+
+    emit( kind, name, t.type_id );
+    push( kind, 0, t.text );
+}
+
+// Skips spaces and comments on the current line. Returns false if nothing else is left on it.
+bool FileStorageReader::Impl::yamlSkipSpaces()
+{
+    while( cv_isspace(*ptr) )
+        ptr++;
+    if( *ptr == '#' )
+        ptr += strlen(ptr);
+    return *ptr != '\0';
+}
+
+void FileStorageReader::Impl::yamlParseString( std::string& str )
+{
+    char quote = *ptr++;
+    str.clear();
+    for( ;; ptr++ )
+    {
+        char c = *ptr;
+        if( c == '\0' || c == '\n' )
+            parseError( "Closing quote is expected" );
+        if( c == quote )
+        {
+            if( quote == '\'' && ptr[1] == '\'' )
+            {
+                str += *++ptr;
+                continue;
+            }
+            ptr++;
+            break;
+        }
+        if( c == '\\' && quote == '\"' )
+        {
+            c = *++ptr;
+            switch( c )
+            {
+            case 'n': str += '\n'; break;
+            case 't': str += '\t'; break;
+            case 'r': str += '\r'; break;
+            case 'b': str += '\b'; break;
+            case 'f': str += '\f'; break;
+            case 'x':
+                {
+                    char hex[3] = { ptr[1], ptr[1] ? ptr[2] : '\0', '\0' };
+                    char* endptr = 0;
+                    str += (char)strtol( hex, &endptr, 16 );
+                    if( endptr != hex + 2 )
+                        parseError( "Invalid escape sequence" );
+                    ptr += 2;
+                }
+                break;
+            case '\0': parseError( "Closing quote is expected" ); break;
+            default: str += c;
+            }
+            continue;
+        }
+        str += c;
+    }
+}
+
+// Reads an unquoted scalar up to the end of the line or a comment; in flow collections
+// also up to the next ',', ']' or '}'.
+void FileStorageReader::Impl::yamlParsePlain( std::string& str, bool flow )
+{
+    char* start = ptr;
+    for( ; *ptr != '\0'; ptr++ )
+    {
+        char c = *ptr;
+        if( (c == '#' && ptr > start && cv_isspace(ptr[-1])) ||
+            (flow && (c == ',' || c == ']' || c == '}')) )
+            break;
+    }
+    char* end = ptr;
+    while( end > start && cv_isspace(end[-1]) )
+        end--;
+    str.assign( start, end );
+}
+
+// Parses the value of a node that starts at ptr: a collection in flow style or a scalar.
+void FileStorageReader::Impl::yamlParseValue( const std::string& name, const std::string& tag )
+{
+    char c = *ptr;
+    if( c == '[' || c == '{' )
+    {
+        int kind = c == '[' ? START_SEQ : START_MAP;
+        emit( kind, name, tag );
+        push( kind, -1, std::string() );
+        ptr++;
+        return;
+    }
+    bool flow = stack.back().indent < 0;
+    Event& e = emit( SCALAR, name, tag );
+    if( c == '\"' || c == '\'' )
+        yamlParseString( e.value );
+    else
+        yamlParsePlain( e.value, flow );
+    if( !flow && yamlSkipSpaces() )
+        parseError( "Unexpected characters after a value" );
+}
+
+void FileStorageReader::Impl::yamlParseFlow()
+{
+    for(;;)
+    {
+        while( !yamlSkipSpaces() )
+            if( !readLine() )
+                parseError( "Unexpected end of file" );
+        if( *ptr != ',' )
+            break;
+        ptr++;
+    }
+
+    int kind = stack.back().kind;
+    char c = *ptr;
+    if( c == ']' || c == '}' )
+    {
+        if( c != (kind == START_SEQ ? ']' : '}') )
+            parseError( "Mismatched closing bracket" );
+        ptr++;
+        stack.pop_back();
+        emit( END, std::string(), std::string() );
+        if( stack.back().indent >= 0 && yamlSkipSpaces() )
+            parseError( "Unexpected characters after the end of a flow collection" );
+        return;
+    }
+
+    std::string name, tag;
+    if( kind == START_MAP )
+    {
+        if( c == '\"' || c == '\'' )
+            yamlParseString( name );
+        else
+        {
+            char* start = ptr;
+            while( *ptr != ':' && *ptr != '\0' && *ptr != ',' && *ptr != '}' )
+                ptr++;
+            char* end = ptr;
+            while( end > start && cv_isspace(end[-1]) )
+                end--;
+            name.assign( start, end );
+        }
+        while( cv_isspace(*ptr) )
+            ptr++;
+        if( *ptr != ':' || name.empty() )
+            parseError( "Missing \':\'" );
+        ptr++;
+        while( !yamlSkipSpaces() )
+            if( !readLine() )
+                parseError( "Unexpected end of file" );
+    }
+    if( ptr[0] == '!' && ptr[1] == '!' )
+    {
+        char* start = ptr += 2;
+        while( *ptr != '\0' && !cv_isspace(*ptr) )
+            ptr++;
+        tag.assign( start, ptr );
+        while( !yamlSkipSpaces() )
+            if( !readLine() )
+                parseError( "Unexpected end of file" );
+    }
+    yamlParseValue( name, tag );
+}
+
+static bool icvYamlIsDash( const char* ptr )
+{
+    return ptr[0] == '-' && (ptr[1] == '\0' || cv_isspace(ptr[1]));
+}
+
+static bool icvYamlIsKey( const char* ptr )
+{
+    if( *ptr == '\"' || *ptr == '\'' )
+    {
+        const char* end = strchr( ptr + 1, *ptr );
+        return end && end[1] == ':' && (end[2] == '\0' || cv_isspace(end[2]));
+    }
+    while( cv_isalnum(*ptr) || *ptr == '_' || *ptr == '-' || *ptr == '.' )
+        ptr++;
+    return *ptr == ':' && (ptr[1] == '\0' || cv_isspace(ptr[1]));
+}
+
+void FileStorageReader::Impl::yamlParse()
+{
+    if( stack.back().indent < 0 )
+    {
+        yamlParseFlow();
+        return;
+    }
+
+    // find the next line with any content
+    for(;;)
+    {
+        if( yamlSkipSpaces() )
+        {
+            if( ptr != &buf[0] || (*ptr != '%' && strncmp( ptr, "---", 3 ) != 0 &&
+                                   strncmp( ptr, "...", 3 ) != 0) )
+                break;
+            ptr += strlen(ptr);
+        }
+        if( !readLine() )
+        {
+            if( pending )
+                emit( SCALAR, pending_name, pending_tag );
+            pending = false;
+            while( stack.size() > 1 )
+            {
+                stack.pop_back();
+                emit( END, std::string(), std::string() );
+            }
+            emit( END_OF_STREAM, std::string(), std::string() );
+            return;
+        }
+    }
+
+    int col = (int)(ptr - &buf[0]);
+    if( pending )
+    {
+        pending = false;
+        if( col > pending_indent )
+        {
+            if( icvYamlIsDash(ptr) || icvYamlIsKey(ptr) )
+            {
+                int kind = icvYamlIsDash(ptr) ? START_SEQ : START_MAP;
+                emit( kind, pending_name, pending_tag );
+                push( kind, col, std::string() );
+            }
+            else
+            {
+                yamlParseValue( pending_name, pending_tag );
+                return;
+            }
+        }
+        else
+            emit( SCALAR, pending_name, pending_tag );
+    }
+
+    // leave the collections this line is not part of
+    while( stack.size() > 1 && (stack.back().indent > col ||
+           (stack.back().indent == col && stack.back().kind == START_SEQ && !icvYamlIsDash(ptr))) )
+    {
+        stack.pop_back();
+        emit( END, std::string(), std::string() );
+    }
+    if( stack.back().indent != col )
+        parseError( "Incorrect indentation" );
+
+    if( stack.back().kind == START_SEQ )
+    {
+        if( !icvYamlIsDash(ptr) )
+            parseError( "Block sequence elements must be preceded with \'-\'" );
+        ptr++;
+        if( !yamlSkipSpaces() )
+        {
+            pending = true;
+            pending_indent = col;
+            pending_name.clear();
+            pending_tag.clear();
+            return;
+        }
+        col = (int)(ptr - &buf[0]);
+        if( !icvYamlIsKey(ptr) )
+        {
+            yamlParseValue( std::string(), std::string() );
+            return;
+        }
+        // "- key: value" opens a map whose keys are aligned with this one
+        emit( START_MAP, std::string(), std::string() );
+        push( START_MAP, col, std::string() );
+    }
+
+    std::string name, tag;
+    if( *ptr == '\"' || *ptr == '\'' )
+        yamlParseString( name );
+    else
+    {
+        char* start = ptr;
+        while( *ptr != ':' && *ptr != '\0' )
+            ptr++;
+        name.assign( start, ptr );
+    }
+    if( *ptr != ':' || name.empty() )
+        parseError( "Missing \':\'" );
+    ptr++;
+    if( yamlSkipSpaces() && ptr[0] == '!' && ptr[1] == '!' )
+    {
+        char* start = ptr += 2;
+        while( *ptr != '\0' && !cv_isspace(*ptr) )
+            ptr++;
+        tag.assign( start, ptr );
+        yamlSkipSpaces();
+    }
+    if( *ptr == '\0' )
+    {
+        pending = true;
+        pending_indent = col;
+        pending_name.swap( name );
+        pending_tag.swap( tag );
+        return;
+    }
+    yamlParseValue( name, tag );
+}
+
+// Parses the plain numbers that follow in the current sequence straight from the line buffer,
+// without going through the events, and stores them to data starting at index i. Stops before
+// anything else, so that next() takes over from there. Returns the index of the next element.
+size_t FileStorageReader::Impl::readNumbers( ReaderStoreFunc store, uchar* data, size_t i, size_t n )
+{
+    if( !queue.empty() || !tokens.empty() || (!is_xml && stack.back().indent >= 0) )
+        return i;
+    for( ; i < n; i++ )
+    {
+        if( is_xml )
+        {
+            if( !xmlSkipSpaces() )
+                break;
+        }
+        else
+        {
+            while( !yamlSkipSpaces() || *ptr == ',' )
+                if( *ptr == ',' )
+                    ptr++;
+                else if( !readLine() )
+                    return i;
+        }
+
+        char* endptr = ptr;
+        double value = icvReaderStrtod( ptr, &endptr );
+        char c = *endptr;
+        if( endptr == ptr || !(c == '\0' || cv_isspace(c) || c == (is_xml ? '<' : ',') || (!is_xml && c == ']')) )
+            break;
+        store( data, i, value );
+        ptr = endptr;
+    }
+    return i;
+}
+
+FileStorageReader::FileStorageReader() {}
+
+FileStorageReader::FileStorageReader( const String& filename )
+{
+    open( filename );
+}
+
+FileStorageReader::~FileStorageReader() {}
+
+bool FileStorageReader::open( const String& filename )
+{
+    release();
+    Ptr<Impl> impl = makePtr<Impl>();
+    if( impl->open( filename ) )
+        p = impl;
+    return isOpened();
+}
+
+bool FileStorageReader::isOpened() const
+{
+    return !p.empty();
+}
+
+void FileStorageReader::release()
+{
+    p.release();
+}
+
+int FileStorageReader::next()
+{
+    CV_Assert( isOpened() );
+    if( p->cur.type == END_OF_STREAM )
+        return END_OF_STREAM;
+    while( p->queue.empty() )
+        p->parse();
+    Impl::Event& e = p->queue.front();
+    p->cur.type = e.type;
+    p->cur.depth = e.depth;
+    p->cur.name.swap( e.name );
+    p->cur.type_name.swap( e.type_name );
+    p->cur.value.swap( e.value );
+    p->queue.pop_front();
+    return p->cur.type;
+}
+
+int FileStorageReader::event() const
+{
+    return p.empty() ? NONE : p->cur.type;
+}
+
+int FileStorageReader::depth() const
+{
+    return p.empty() ? 0 : p->cur.depth;
+}
+
+String FileStorageReader::name() const
+{
+    return p.empty() ? String() : String( p->cur.name );
+}
+
+String FileStorageReader::typeName() const
+{
+    return p.empty() ? String() : String( p->cur.type_name );
+}
+
+String FileStorageReader::str() const
+{
+    return p.empty() ? String() : String( p->cur.value );
+}
+
+double FileStorageReader::real() const
+{
+    double value = 0;
+    if( event() != SCALAR || !icvReaderParseReal( p->cur.value, value ) )
+        CV_Error( CV_StsBadArg, "The reader is not at a numeric scalar" );
+    return value;
+}
+
+void FileStorageReader::skip()
+{
+    int e = event();
+    if( e != START_MAP && e != START_SEQ )
+        return;
+    int level = depth();
+    for(;;)
+    {
+        e = next();
+        if( e == END && depth() == level )
+            break;
+        if( e == END_OF_STREAM )
+            p->parseError( "Unexpected end of file" );
+    }
+}
+
+void FileStorageReader::readMat( Mat& m )
+{
+    String type_name = typeName();
+    if( event() != START_MAP || (type_name != "opencv-matrix" && type_name != "opencv-nd-matrix") )
+        CV_Error( CV_StsBadArg, "The reader is not at the start of a matrix" );
+
+    int level = depth();
+    int rows = -1, cols = -1, type = -1;
+    std::vector<int> sizes;
+    bool is_nd = type_name == "opencv-nd-matrix", have_data = false;
+    std::string raw_offset, raw_crc;
+    Mat dst;
+
+    for(;;)
+    {
+        int e = next();
+        if( e == END && depth() == level )
+            break;
+        if( e == END_OF_STREAM )
+            p->parseError( "Unexpected end of file" );
+        const std::string& key = p->cur.name;
+
+        if( key == "sizes" && e == START_SEQ )
+        {
+            while( next() == SCALAR )
+                sizes.push_back( cvRound(real()) );
+            if( event() != END )
+                p->parseError( "Invalid matrix sizes" );
+        }
+        else if( key == "data" && (e == START_SEQ || e == SCALAR) )
+        {
+            if( type < 0 || (is_nd ? sizes.empty() : rows < 0 || cols < 0) )
+                p->parseError( "The matrix header should precede its data" );
+            if( is_nd )
+                m.create( (int)sizes.size(), &sizes[0], type );
+            else
+                m.create( rows, cols, type );
+            dst = m.isContinuous() ? m : Mat( m.dims, m.size.p, type );
+
+            ReaderStoreFunc store = getReaderStoreFunc( CV_MAT_DEPTH(type) );
+            CV_Assert( store != 0 );
+            size_t i = 0, n = dst.total()*dst.channels();
+            double value = 0;
+            if( e == SCALAR )
+            {
+                // a single element is written without brackets
+                if( !icvReaderParseReal( p->cur.value, value ) )
+                    p->parseError( "Invalid matrix element" );
+                store( dst.data, i++, value );
+            }
+            else
+            {
+                for(;;)
+                {
+                    i = p->readNumbers( store, dst.data, i, n );
+                    if( next() != SCALAR )
+                        break;
+                    if( i >= n || !icvReaderParseReal( p->cur.value, value ) )
+                        p->parseError( "Invalid matrix element" );
+                    store( dst.data, i++, value );
+                }
+                if( event() != END )
+                    p->parseError( "Invalid matrix element" );
+            }
+            if( i != n )
+                p->parseError( "The number of matrix elements does not match its size" );
+            have_data = true;
+        }
+        else if( e == SCALAR )
+        {
+            if( key == "rows" )
+                rows = cvRound( real() );
+            else if( key == "cols" )
+                cols = cvRound( real() );
+            else if( key == "dt" )
+                type = icvDecodeSimpleFormat( p->cur.value.c_str() );
+            else if( key == "raw_offset" )
+                raw_offset = p->cur.value;
+            else if( key == "raw_crc32" )
+                raw_crc = p->cur.value;
+        }
+        else
+            skip();
+    }
+
+    if( !have_data )
+    {
+        if( raw_offset.empty() || type < 0 || (is_nd ? sizes.empty() : rows < 0 || cols < 0) )
+            p->parseError( "The matrix data is not found" );
+        if( is_nd )
+            m.create( (int)sizes.size(), &sizes[0], type );
+        else
+            m.create( rows, cols, type );
+        dst = m.isContinuous() ? m : Mat( m.dims, m.size.p, type );
+
+        int64 offset = 0;
+        const char* ptr = raw_offset.c_str();
+        for( ; cv_isdigit(*ptr) && offset <= ((int64)((uint64)-1 >> 1) - 9)/10; ptr++ )
+            offset = offset*10 + (*ptr - '0');
+        if( ptr == raw_offset.c_str() || *ptr != '\0' )
+            p->parseError( "Invalid sidecar offset" );
+        String name = p->filename + ".raw";
+        FILE* f = fopen( name.c_str(), "rb" );
+        if( !f )
+            CV_Error_( CV_StsError, ("Could not open the sidecar file %s", name.c_str()) );
+        size_t size = dst.total()*dst.elemSize();
+#if defined WIN32 || defined _WIN32
+        bool ok = _fseeki64( f, offset, SEEK_SET ) == 0;
+#else
+        bool ok = fseeko( f, (off_t)offset, SEEK_SET ) == 0;
+#endif
+        ok = ok && fread( dst.data, 1, size, f ) == size;
+        fclose( f );
+        if( !ok )
+            CV_Error( CV_StsOutOfRange, "The matrix data lies outside of the sidecar file" );
+        if( !raw_crc.empty() && icvSidecarCRC( 0, dst.data, size ) != (unsigned)strtoul( raw_crc.c_str(), 0, 16 ) )
+            CV_Error( CV_StsParseError, "The checksum of the matrix data in the sidecar file does not match" );
+    }
+
+    if( dst.data != m.data )
+        dst.copyTo( m );
+}
+
+}
+
 /* End of file. */
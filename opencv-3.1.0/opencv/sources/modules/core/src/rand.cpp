@@ -478,6 +478,87 @@ static RandnScaleFunc randnScaleTab[] =
     (RandnScaleFunc)randnScale_64f, 0
 };
 
+/*
+   The multiply-with-carry step is a multiplication modulo m = CV_RNG_COEFF*2^32 - 1
+   in disguise: for any state x in [1, m) RNG_NEXT(x) == x*CV_RNG_COEFF mod m.
+   So the state n steps ahead is x*CV_RNG_COEFF^n mod m, and RNG::fill can start
+   every block of a uniformly distributed array on its own thread while producing
+   exactly the same numbers as the sequential loop.
+*/
+static const uint64 RNG_MODULUS = (uint64)CV_RNG_COEFF*((uint64)1 << 32) - 1;
+
+static uint64 rngMulMod( uint64 a, uint64 b )
+{
+    const uint64 m = RNG_MODULUS;
+    uint64 r = 0;
+    for( ; b > 0; b >>= 1 )
+    {
+        if( b & 1 )
+            r = r >= m - a ? r - (m - a) : r + a;
+        a = a >= m - a ? a - (m - a) : a + a;
+    }
+    return r;
+}
+
+static uint64 rngSkip( uint64 state, uint64 n )
+{
+    if( n > 0 && state >= RNG_MODULUS )
+    {
+        state = RNG_NEXT(state);
+        n--;
+    }
+    for( uint64 a = CV_RNG_COEFF; n > 0; n >>= 1 )
+    {
+        if( n & 1 )
+            state = rngMulMod(state, a);
+        a = rngMulMod(a, a);
+    }
+    return state;
+}
+
+// the number of generator steps the uniform RandFunc's take to produce len values
+static uint64 randSteps( int len, bool small_flag )
+{
+    return small_flag ? (uint64)(len/4 + len%4) : (uint64)len;
+}
+
+class RandUniformInvoker : public ParallelLoopBody
+{
+public:
+    RandUniformInvoker( const Mat& _mat, RandFunc _func, const uchar* _param, bool _smallFlag,
+                        uint64 _state, int _blockSize, int _nblocks )
+        : mat(_mat), func(_func), param(_param), smallFlag(_smallFlag), state(_state),
+          blockSize(_blockSize), nblocks(_nblocks) {}
+
+    void operator()( const Range& range ) const
+    {
+        int cn = mat.channels();
+        int total = mat.isContinuous() ? (int)mat.total() : mat.cols;
+        size_t esz = mat.elemSize();
+        uint64 blockSteps = randSteps(blockSize*cn, smallFlag);
+        uint64 planeSteps = (nblocks - 1)*blockSteps + randSteps((total - (nblocks - 1)*blockSize)*cn, smallFlag);
+        int i = range.start / nblocks, j = range.start % nblocks;
+        uint64 temp = rngSkip(state, i*planeSteps + j*blockSteps);
+
+        for( int b = range.start; b < range.end; b++, j++ )
+        {
+            if( j == nblocks )
+                i++, j = 0;
+            int len = std::min(total - j*blockSize, blockSize);
+            uchar* ptr = (mat.isContinuous() ? mat.ptr() : mat.ptr(i)) + j*blockSize*esz;
+            func( ptr, len*cn, &temp, param, smallFlag );
+        }
+    }
+
+private:
+    Mat mat;
+    RandFunc func;
+    const uchar* param;
+    bool smallFlag;
+    uint64 state;
+    int blockSize, nblocks;
+};
+
 void RNG::fill( InputOutputArray _mat, int disttype,
                 InputArray _param1arg, InputArray _param2arg, bool saturateRange )
 {
@@ -709,6 +790,20 @@ void RNG::fill( InputOutputArray _mat, int disttype,
         nbuf = (float*)(double*)buf;
     }
 
+    int nblocks = (total + blockSize - 1)/blockSize;
+    int nstripes = (int)std::min(it.nplanes*nblocks, mat.total()*cn >> 16);
+    if( disttype == UNIFORM && mat.dims <= 2 && nstripes > 1 )
+    {
+        // only randBits_ packs several values into one step
+        bool smallBits = fast_int_mode && smallFlag;
+        parallel_for_(Range(0, (int)it.nplanes*nblocks),
+                      RandUniformInvoker(mat, func, param, smallBits, state, blockSize, nblocks),
+                      nstripes);
+        state = rngSkip(state, it.nplanes*((nblocks - 1)*randSteps(blockSize*cn, smallBits) +
+                               randSteps((total - (nblocks - 1)*blockSize)*cn, smallBits)));
+        return;
+    }
+
     for( size_t i = 0; i < it.nplanes; i++, ++it )
     {
         for( j = 0; j < total; j += blockSize )
@@ -833,6 +928,433 @@ CV_IMPL void cvRandShuffle( CvArr* arr, CvRNG* _rng, double iter_factor )
     cv::randShuffle( dst, iter_factor, &rng );
 }
 
+///////////////////////////////// Philox4x32-10 /////////////////////////////////
+
+namespace cv
+{
+
+static const unsigned PHILOX_M0 = 0xD2511F53U, PHILOX_M1 = 0xCD9E8D57U;
+static const unsigned PHILOX_W0 = 0x9E3779B9U, PHILOX_W1 = 0xBB67AE85U;
+
+enum { PHILOX_CHUNK = 1024, PHILOX_STRIPE = 1 << 16 };
+
+static inline void philoxBlock( uint64 ctr, uint64 key, unsigned* out )
+{
+    unsigned c0 = (unsigned)ctr, c1 = (unsigned)(ctr >> 32), c2 = 0, c3 = 0;
+    unsigned k0 = (unsigned)key, k1 = (unsigned)(key >> 32);
+
+    for( int r = 0; r < 10; r++, k0 += PHILOX_W0, k1 += PHILOX_W1 )
+    {
+        uint64 p0 = (uint64)PHILOX_M0*c0, p1 = (uint64)PHILOX_M1*c2;
+        c0 = (unsigned)(p1 >> 32) ^ c1 ^ k0;
+        c2 = (unsigned)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (unsigned)p1;
+        c3 = (unsigned)p0;
+    }
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+#if CV_SSE2
+static inline void philoxMulHiLo( __m128i a, __m128i m, __m128i& hi, __m128i& lo )
+{
+    __m128i p02 = _mm_mul_epu32(a, m), p13 = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+    lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(p02, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(p13, _MM_SHUFFLE(0, 0, 2, 0)));
+    hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(p02, _MM_SHUFFLE(0, 0, 3, 1)),
+                            _mm_shuffle_epi32(p13, _MM_SHUFFLE(0, 0, 3, 1)));
+}
+#endif
+
+// writes blocks ctr, ctr+1, ..., ctr+n-1 of the stream
+static void philoxBlocks( uint64 ctr, uint64 key, int n, unsigned* out )
+{
+    int i = 0;
+#if CV_SSE2
+    const __m128i m0 = _mm_set1_epi32((int)PHILOX_M0), m1 = _mm_set1_epi32((int)PHILOX_M1);
+    for( ; i <= n - 4; i += 4, out += 16 )
+    {
+        // lane j processes block ctr + i + j
+        uint64 b = ctr + i;
+        __m128i c0 = _mm_setr_epi32((int)b, (int)(b + 1), (int)(b + 2), (int)(b + 3));
+        __m128i c1 = _mm_setr_epi32((int)(b >> 32), (int)((b + 1) >> 32), (int)((b + 2) >> 32), (int)((b + 3) >> 32));
+        __m128i c2 = _mm_setzero_si128(), c3 = _mm_setzero_si128();
+        unsigned k0 = (unsigned)key, k1 = (unsigned)(key >> 32);
+
+        for( int r = 0; r < 10; r++, k0 += PHILOX_W0, k1 += PHILOX_W1 )
+        {
+            __m128i hi0, lo0, hi1, lo1;
+            philoxMulHiLo(c0, m0, hi0, lo0);
+            philoxMulHiLo(c2, m1, hi1, lo1);
+            c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32((int)k0));
+            c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32((int)k1));
+            c1 = lo1;
+            c3 = lo0;
+        }
+
+        __m128i t0 = _mm_unpacklo_epi32(c0, c1), t1 = _mm_unpacklo_epi32(c2, c3);
+        __m128i t2 = _mm_unpackhi_epi32(c0, c1), t3 = _mm_unpackhi_epi32(c2, c3);
+        _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128((__m128i*)(out + 4), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128((__m128i*)(out + 8), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128((__m128i*)(out + 12), _mm_unpackhi_epi64(t2, t3));
+    }
+#endif
+    for( ; i < n; i++, out += 4 )
+        philoxBlock(ctr + i, key, out);
+}
+
+// writes the words w, w+1, ..., w+n-1 of the stream that starts at block ctr
+static void philoxWords( uint64 ctr, uint64 key, uint64 w, int n, unsigned* out )
+{
+    unsigned tmp[4];
+    ctr += w/4;
+    int k = (int)(w % 4);
+    if( k > 0 )
+    {
+        philoxBlock(ctr++, key, tmp);
+        for( ; k < 4 && n > 0; k++, n-- )
+            *out++ = tmp[k];
+    }
+    philoxBlocks(ctr, key, n/4, out);
+    ctr += n/4;
+    out += n & -4;
+    if( n % 4 )
+    {
+        philoxBlock(ctr, key, tmp);
+        for( k = 0; k < n % 4; k++ )
+            out[k] = tmp[k];
+    }
+}
+
+// Box-Muller transform of the word pairs (w[2k], w[2k+1]) to normally distributed z[2k], z[2k+1]
+static void philoxGaussian( const unsigned* w, int npairs, float* z, float* buf )
+{
+    float *u1 = buf, *u2 = buf + npairs, *x = buf + npairs*2, *y = buf + npairs*3;
+    const float scale = 1.f/16777216; // 2**-24
+    int k = 0;
+#if CV_SSE2
+    const __m128 v_scale = _mm_set1_ps(scale);
+    for( ; k <= npairs - 4; k += 4 )
+    {
+        __m128i w0 = _mm_loadu_si128((const __m128i*)(w + k*2));
+        __m128i w1 = _mm_loadu_si128((const __m128i*)(w + k*2 + 4));
+        // deinterleave the pairs
+        __m128i a = _mm_shuffle_epi32(w0, _MM_SHUFFLE(3, 1, 2, 0)), b = _mm_shuffle_epi32(w1, _MM_SHUFFLE(3, 1, 2, 0));
+        __m128i even = _mm_unpacklo_epi64(a, b), odd = _mm_unpackhi_epi64(a, b);
+        __m128 v1 = _mm_cvtepi32_ps(_mm_add_epi32(_mm_srli_epi32(even, 8), _mm_set1_epi32(1)));
+        __m128 v2 = _mm_cvtepi32_ps(_mm_srli_epi32(odd, 8));
+        _mm_storeu_ps(u1 + k, _mm_mul_ps(v1, v_scale));
+        _mm_storeu_ps(u2 + k, _mm_mul_ps(v2, _mm_set1_ps((float)(CV_PI*2)*scale)));
+    }
+#endif
+    for( ; k < npairs; k++ )
+    {
+        u1[k] = (float)((w[k*2] >> 8) + 1)*scale;
+        u2[k] = (float)(w[k*2 + 1] >> 8)*((float)(CV_PI*2)*scale);
+    }
+
+    // u1 is in (0, 1], so the radius sqrt(-2*log(u1)) is finite
+    hal::log32f(u1, u1, npairs);
+    k = 0;
+#if CV_SSE2
+    for( ; k <= npairs - 4; k += 4 )
+        _mm_storeu_ps(u1 + k, _mm_mul_ps(_mm_loadu_ps(u1 + k), _mm_set1_ps(-2.f)));
+#endif
+    for( ; k < npairs; k++ )
+        u1[k] *= -2.f;
+    hal::sqrt32f(u1, u1, npairs);
+
+    Mat xm(1, npairs, CV_32F, x), ym(1, npairs, CV_32F, y);
+    polarToCart(Mat(1, npairs, CV_32F, u1), Mat(1, npairs, CV_32F, u2), xm, ym, false);
+    for( k = 0; k < npairs; k++ )
+    {
+        z[k*2] = x[k];
+        z[k*2 + 1] = y[k];
+    }
+}
+
+template<typename T> static void
+philoxUniformInt( const unsigned* w, T* dst, int n, const int64* lo, const int64* d )
+{
+    for( int i = 0; i < n; i++ )
+        dst[i] = saturate_cast<T>(lo[i] + (int64)(((uint64)w[i]*(uint64)d[i]) >> 32));
+}
+
+static void
+philoxUniform32f( const unsigned* w, float* dst, int n, const float* scale, const float* shift )
+{
+    int i = 0;
+#if CV_SSE2
+    for( ; i <= n - 4; i += 4 )
+    {
+        __m128 v = _mm_cvtepi32_ps(_mm_srli_epi32(_mm_loadu_si128((const __m128i*)(w + i)), 8));
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(v, _mm_loadu_ps(scale + i)), _mm_loadu_ps(shift + i)));
+    }
+#endif
+    for( ; i < n; i++ )
+        dst[i] = (float)(w[i] >> 8)*scale[i] + shift[i];
+}
+
+static void
+philoxUniform64f( const unsigned* w, double* dst, int n, const double* scale, const double* shift )
+{
+    for( int i = 0; i < n; i++ )
+        dst[i] = ((w[i*2] >> 5)*67108864.0 + (w[i*2 + 1] >> 6))*scale[i] + shift[i];
+}
+
+template<typename T, typename PT> static void
+philoxScale( const float* z, T* dst, int n, const PT* mean, const PT* stddev )
+{
+    for( int i = 0; i < n; i++ )
+        dst[i] = saturate_cast<T>(z[i]*stddev[i] + mean[i]);
+}
+
+static void
+philoxScale32f( const float* z, float* dst, int n, const float* mean, const float* stddev )
+{
+    int i = 0;
+#if CV_SSE2
+    for( ; i <= n - 4; i += 4 )
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(z + i), _mm_loadu_ps(stddev + i)),
+                                          _mm_loadu_ps(mean + i)));
+#endif
+    for( ; i < n; i++ )
+        dst[i] = z[i]*stddev[i] + mean[i];
+}
+
+/*
+   Fills a 2D single-channel view of the array (rows of whole pixels). The scalar with the
+   flat index e (counted from the start of the whole array) is made of the words
+   [e*wpv, (e+1)*wpv) of the stream, and the per-channel parameters p1/p2 are repeated
+   with the period cn, so the output does not depend on how the array is split.
+*/
+class PhiloxFillInvoker : public ParallelLoopBody
+{
+public:
+    PhiloxFillInvoker( const Mat& _mat, int _cn, int _disttype, uint64 _key, uint64 _ctr, size_t _ofs,
+                       const uchar* _p1, const uchar* _p2 )
+        : mat(_mat), cn(_cn), disttype(_disttype), key(_key), ctr(_ctr), ofs(_ofs), p1(_p1), p2(_p2) {}
+
+    void operator()( const Range& range ) const
+    {
+        int depth = mat.depth(), width = mat.cols;
+        size_t esz = mat.elemSize(), total = mat.total();
+        AutoBuffer<unsigned> _wbuf(PHILOX_CHUNK*2 + 2);
+        AutoBuffer<float> _fbuf(PHILOX_CHUNK*3 + 8);
+        unsigned* wbuf = _wbuf;
+        float *zbuf = _fbuf, *tbuf = zbuf + PHILOX_CHUNK + 2;
+
+        for( int s = range.start; s < range.end; s++ )
+        {
+            size_t e = (size_t)s*PHILOX_STRIPE, end = std::min(total, e + PHILOX_STRIPE);
+            while( e < end )
+            {
+                int y = (int)(e / width), x = (int)(e % width);
+                int len = (int)std::min((size_t)(width - x), std::min(end - e, (size_t)PHILOX_CHUNK));
+                fillChunk(mat.ptr(y) + x*esz, depth, (uint64)(ofs + e), len, wbuf, zbuf, tbuf);
+                e += len;
+            }
+        }
+    }
+
+private:
+    void fillChunk( uchar* dst, int depth, uint64 e, int n, unsigned* w, float* z, float* buf ) const
+    {
+        int c = (int)(e % cn);
+        if( disttype == RNG::UNIFORM )
+        {
+            if( depth == CV_64F )
+            {
+                philoxWords(ctr, key, e*2, n*2, w);
+                philoxUniform64f(w, (double*)dst, n, (const double*)p1 + c, (const double*)p2 + c);
+                return;
+            }
+            philoxWords(ctr, key, e, n, w);
+            const int64 *lo = (const int64*)p1 + c, *d = (const int64*)p2 + c;
+            switch( depth )
+            {
+            case CV_8U: philoxUniformInt(w, dst, n, lo, d); break;
+            case CV_8S: philoxUniformInt(w, (schar*)dst, n, lo, d); break;
+            case CV_16U: philoxUniformInt(w, (ushort*)dst, n, lo, d); break;
+            case CV_16S: philoxUniformInt(w, (short*)dst, n, lo, d); break;
+            case CV_32S: philoxUniformInt(w, (int*)dst, n, lo, d); break;
+            default: philoxUniform32f(w, (float*)dst, n, (const float*)p1 + c, (const float*)p2 + c);
+            }
+            return;
+        }
+
+        // the pairs covering [e, e + n)
+        uint64 e0 = e & ~(uint64)1;
+        int npairs = (int)((e + n + 1)/2 - e0/2);
+        philoxWords(ctr, key, e0, npairs*2, w);
+        philoxGaussian(w, npairs, z, buf);
+        z += e - e0;
+
+        if( depth == CV_64F )
+        {
+            philoxScale(z, (double*)dst, n, (const double*)p1 + c, (const double*)p2 + c);
+            return;
+        }
+        const float *mean = (const float*)p1 + c, *stddev = (const float*)p2 + c;
+        switch( depth )
+        {
+        case CV_8U: philoxScale(z, dst, n, mean, stddev); break;
+        case CV_8S: philoxScale(z, (schar*)dst, n, mean, stddev); break;
+        case CV_16U: philoxScale(z, (ushort*)dst, n, mean, stddev); break;
+        case CV_16S: philoxScale(z, (short*)dst, n, mean, stddev); break;
+        case CV_32S: philoxScale(z, (int*)dst, n, mean, stddev); break;
+        default: philoxScale32f(z, (float*)dst, n, mean, stddev);
+        }
+    }
+
+    Mat mat;
+    int cn, disttype;
+    uint64 key, ctr;
+    size_t ofs;
+    const uchar *p1, *p2;
+};
+
+}
+
+cv::RNG_Philox::RNG_Philox() { seed(0); }
+
+cv::RNG_Philox::RNG_Philox(uint64 _key) { seed(_key); }
+
+void cv::RNG_Philox::seed(uint64 _key)
+{
+    key = _key;
+    counter = 0;
+    pos = 4;
+}
+
+unsigned cv::RNG_Philox::next()
+{
+    if( pos == 4 )
+    {
+        philoxBlock(counter++, key, words);
+        pos = 0;
+    }
+    return words[pos++];
+}
+
+cv::RNG_Philox::operator unsigned() { return next(); }
+
+cv::RNG_Philox::operator float() { return next() * (1.f / 4294967296.f); }
+
+cv::RNG_Philox::operator double()
+{
+    unsigned a = next() >> 5;
+    unsigned b = next() >> 6;
+    return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+}
+
+int cv::RNG_Philox::uniform(int a, int b)
+{
+    return a == b ? a : (int)(a + (int64)(((uint64)next()*(unsigned)(b - a)) >> 32));
+}
+
+float cv::RNG_Philox::uniform(float a, float b) { return ((float)*this)*(b - a) + a; }
+
+double cv::RNG_Philox::uniform(double a, double b) { return ((double)*this)*(b - a) + a; }
+
+double cv::RNG_Philox::gaussian(double sigma)
+{
+    double u1 = ((next() >> 8) + 1)*(1./16777216), u2 = (next() >> 8)*(1./16777216);
+    return std::sqrt(-2*std::log(u1))*std::cos(CV_PI*2*u2)*sigma;
+}
+
+void cv::RNG_Philox::fill( InputOutputArray _mat, int disttype,
+                           InputArray _param1arg, InputArray _param2arg, bool saturateRange )
+{
+    Mat mat = _mat.getMat(), _param1, _param2;
+    int depth = mat.depth(), cn = mat.channels();
+    _param1arg.getMat().convertTo(_param1, CV_64F);
+    _param2arg.getMat().convertTo(_param2, CV_64F);
+    int n1 = (int)_param1.total(), n2 = (int)_param2.total();
+
+    CV_Assert( _param1.channels() == 1 && (_param1.rows == 1 || _param1.cols == 1) &&
+               _param2.channels() == 1 && (_param2.rows == 1 || _param2.cols == 1) &&
+               (n1 == 1 || n1 >= cn) && (n2 == 1 || n2 >= cn) );
+    if( disttype != UNIFORM && disttype != NORMAL )
+        CV_Error( CV_StsBadArg, "Unknown distribution type" );
+
+    // the per-channel parameters, repeated for PHILOX_CHUNK + cn scalars
+    int tlen = PHILOX_CHUNK + cn;
+    AutoBuffer<int64> _tab(tlen*2);
+    uchar *p1 = (uchar*)(int64*)_tab, *p2 = (uchar*)((int64*)_tab + tlen);
+    const double* a = _param1.ptr<double>();
+    const double* b = _param2.ptr<double>();
+
+    for( int j = 0; j < tlen; j++ )
+    {
+        int k = j % cn;
+        double v1 = a[n1 == 1 ? 0 : k], v2 = b[n2 == 1 ? 0 : k];
+        if( disttype == NORMAL )
+        {
+            if( depth == CV_64F )
+                ((double*)p1)[j] = v1, ((double*)p2)[j] = v2;
+            else
+                ((float*)p1)[j] = (float)v1, ((float*)p2)[j] = (float)v2;
+        }
+        else if( depth <= CV_32S )
+        {
+            double lo = std::min(v1, v2), hi = std::max(v1, v2);
+            double minval = depth == CV_8U || depth == CV_16U ? 0. : depth == CV_8S ? -128. :
+                            depth == CV_16S ? -32768. : (double)INT_MIN;
+            double maxval = depth == CV_8U ? 256. : depth == CV_16U ? 65536. : depth == CV_8S ? 128. :
+                            depth == CV_16S ? 32768. : (double)INT_MAX + 1;
+            if( !saturateRange )
+                minval = INT_MIN, maxval = (double)INT_MAX + 1;
+            lo = std::max(lo, minval);
+            hi = std::min(hi, maxval);
+            int64 ilo = (int64)std::ceil(lo), ihi = (int64)std::floor(hi);
+            ((int64*)p1)[j] = ilo;
+            ((int64*)p2)[j] = std::max(ihi - ilo, (int64)0);
+        }
+        else
+        {
+            double maxdiff = saturateRange ? (double)FLT_MAX : DBL_MAX;
+            if( depth == CV_32F )
+            {
+                ((float*)p1)[j] = (float)(std::min(maxdiff, v2 - v1)*(1./16777216));
+                ((float*)p2)[j] = (float)v1;
+            }
+            else
+            {
+                ((double*)p1)[j] = std::min(maxdiff, v2 - v1)*(1./9007199254740992.);
+                ((double*)p2)[j] = v1;
+            }
+        }
+    }
+
+    uint64 wpv = disttype == UNIFORM && depth == CV_64F ? 2 : 1;
+    size_t total = mat.total()*cn;
+    if( mat.isContinuous() || mat.dims <= 2 )
+    {
+        Mat plane = mat.isContinuous() ? Mat(1, (int)total, depth, mat.ptr()) : mat.reshape(1);
+        int nstripes = (int)((plane.total() + PHILOX_STRIPE - 1)/PHILOX_STRIPE);
+        parallel_for_(Range(0, nstripes), PhiloxFillInvoker(plane, cn, disttype, key, counter, 0, p1, p2));
+    }
+    else
+    {
+        const Mat* arrays[] = {&mat, 0};
+        uchar* ptr;
+        NAryMatIterator it(arrays, &ptr);
+        size_t ofs = 0, planeSize = it.size*cn;
+        for( size_t i = 0; i < it.nplanes; i++, ++it, ofs += planeSize )
+        {
+            Mat plane(1, (int)planeSize, depth, ptr);
+            int nstripes = (int)((planeSize + PHILOX_STRIPE - 1)/PHILOX_STRIPE);
+            parallel_for_(Range(0, nstripes), PhiloxFillInvoker(plane, cn, disttype, key, counter, ofs, p1, p2));
+        }
+    }
+
+    // normally distributed values are made of whole pairs of words
+    uint64 nwords = disttype == NORMAL ? (total + 1) & ~(uint64)1 : total*wpv;
+    counter += (nwords + 3)/4;
+    pos = 4;
+}
+
 // Mersenne Twister random number generator.
 // Inspired by http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/MT2002/CODES/mt19937ar.c
 
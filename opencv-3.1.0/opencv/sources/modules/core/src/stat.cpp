@@ -1190,6 +1190,81 @@ static bool ipp_sum(Mat &src, Scalar &_res)
 
 }
 
+namespace cv
+{
+
+// reductions over more than two stripes of this many elements are computed in parallel
+enum { REDUCE_STRIPE_SIZE = 1 << 16 };
+
+/* Cuts an array into stripes for a parallel reduction: a continuous array into runs of elements,
+   regardless of its shape, any other 2D array into ranges of rows. The cut depends only on the
+   size of the array, so merging the partial results in the order of the stripes gives the same
+   result with any number of threads. */
+class ReduceStripes
+{
+public:
+    ReduceStripes( const Mat& _src, const Mat& _mask ) : src(_src), mask(_mask), n(1), by_rows(false)
+    {
+        size_t total = src.total();
+        if( total < (size_t)REDUCE_STRIPE_SIZE*2 || (!mask.empty() && mask.size != src.size) )
+            return;
+        if( src.isContinuous() && (mask.empty() || mask.isContinuous()) )
+            n = (int)std::min( total/REDUCE_STRIPE_SIZE, (size_t)INT_MAX );
+        else if( src.dims <= 2 )
+        {
+            by_rows = true;
+            n = (int)std::min( total/REDUCE_STRIPE_SIZE, (size_t)src.rows );
+        }
+    }
+
+    int count() const { return n; }
+
+    // Sets the headers of the i-th stripe and returns the offset of its first element
+    size_t get( int i, Mat& s, Mat& m ) const
+    {
+        if( by_rows )
+        {
+            int y0 = (int)((int64)src.rows*i/n), y1 = (int)((int64)src.rows*(i+1)/n);
+            s = src.rowRange(y0, y1);
+            m = mask.empty() ? Mat() : mask.rowRange(y0, y1);
+            return (size_t)y0*src.cols;
+        }
+        size_t total = src.total(), len = total/n, rem = total % n;
+        size_t ofs = len*i + std::min((size_t)i, rem);
+        len += (size_t)i < rem;
+        s = Mat( 1, (int)len, src.type(), (void*)(src.data + ofs*src.elemSize()) );
+        m = mask.empty() ? Mat() : Mat( 1, (int)len, mask.type(), (void*)(mask.data + ofs) );
+        return ofs;
+    }
+
+protected:
+    Mat src, mask;
+    int n;
+    bool by_rows;
+};
+
+class SumInvoker : public ParallelLoopBody
+{
+public:
+    SumInvoker( const ReduceStripes& _stripes, Scalar* _sums ) : stripes(_stripes), sums(_sums) {}
+
+    void operator()( const Range& range ) const
+    {
+        Mat src, mask;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            stripes.get( i, src, mask );
+            sums[i] = sum( src );
+        }
+    }
+
+protected:
+    const ReduceStripes& stripes;
+    Scalar* sums;
+};
+
+}
+
 cv::Scalar cv::sum( InputArray _src )
 {
 #if defined HAVE_OPENCL || defined HAVE_IPP
@@ -1209,6 +1284,17 @@ cv::Scalar cv::sum( InputArray _src )
     SumFunc func = getSumFunc(depth);
     CV_Assert( cn <= 4 && func != 0 );
 
+    ReduceStripes stripes( src, Mat() );
+    if( stripes.count() > 1 )
+    {
+        std::vector<Scalar> sums( stripes.count() );
+        parallel_for_( Range(0, stripes.count()), SumInvoker(stripes, &sums[0]) );
+        Scalar s;
+        for( k = 0; k < stripes.count(); k++ )
+            s += sums[k];
+        return s;
+    }
+
     const Mat* arrays[] = {&src, 0};
     uchar* ptrs[1];
     NAryMatIterator it(arrays, ptrs);
@@ -1753,16 +1839,13 @@ static bool ipp_meanStdDev(Mat& src, OutputArray _mean, OutputArray _sdv, Mat& m
 }
 #endif
 
-void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray _mask )
+namespace cv
 {
-    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-               ocl_meanStdDev(_src, _mean, _sdv, _mask))
-
-    Mat src = _src.getMat(), mask = _mask.getMat();
-    CV_Assert( mask.empty() || mask.type() == CV_8UC1 );
-
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_meanStdDev(src, _mean, _sdv, mask));
 
+// Computes the per-channel sums and sums of squares of the elements of src selected by mask.
+// Returns the number of selected elements.
+static int sumSqr( const Mat& src, const Mat& mask, double* s, double* sq )
+{
     int k, cn = src.channels(), depth = src.depth();
 
     SumSqrFunc func = getSumSqrTab(depth);
@@ -1774,8 +1857,7 @@ void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, Input
     NAryMatIterator it(arrays, ptrs);
     int total = (int)it.size, blockSize = total, intSumBlockSize = 0;
     int j, count = 0, nz0 = 0;
-    AutoBuffer<double> _buf(cn*4);
-    double *s = (double*)_buf, *sq = s + cn;
+    AutoBuffer<double> _buf(cn*2);
     int *sbuf = (int*)s, *sqbuf = (int*)sq;
     bool blockSum = depth <= CV_16S, blockSqSum = depth <= CV_8S;
     size_t esz = 0;
@@ -1787,7 +1869,7 @@ void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, Input
     {
         intSumBlockSize = 1 << 15;
         blockSize = std::min(blockSize, intSumBlockSize);
-        sbuf = (int*)(sq + cn);
+        sbuf = (int*)(double*)_buf;
         if( blockSqSum )
             sqbuf = sbuf + cn;
         for( k = 0; k < cn; k++ )
@@ -1826,6 +1908,73 @@ void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, Input
         }
     }
 
+    return nz0;
+}
+
+class SumSqrInvoker : public ParallelLoopBody
+{
+public:
+    SumSqrInvoker( const ReduceStripes& _stripes, double* _sums, int* _nz, int _cn )
+        : stripes(_stripes), sums(_sums), nz(_nz), cn(_cn) {}
+
+    void operator()( const Range& range ) const
+    {
+        Mat src, mask;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            stripes.get( i, src, mask );
+            double* s = sums + i*cn*2;
+            nz[i] = sumSqr( src, mask, s, s + cn );
+        }
+    }
+
+protected:
+    const ReduceStripes& stripes;
+    double* sums;
+    int* nz;
+    int cn;
+};
+
+}
+
+void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray _mask )
+{
+    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+               ocl_meanStdDev(_src, _mean, _sdv, _mask))
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    CV_Assert( mask.empty() || mask.type() == CV_8UC1 );
+
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_meanStdDev(src, _mean, _sdv, mask));
+
+    int k, j, cn = src.channels(), nz0 = 0;
+    AutoBuffer<double> _buf(cn*2);
+    double *s = (double*)_buf, *sq = s + cn;
+
+    ReduceStripes stripes( src, mask );
+    if( stripes.count() > 1 )
+    {
+        int n = stripes.count();
+        AutoBuffer<double> _sums(n*cn*2);
+        AutoBuffer<int> _nz(n);
+        double* sums = _sums;
+        int* nz = _nz;
+        parallel_for_( Range(0, n), SumSqrInvoker(stripes, sums, nz, cn) );
+        for( k = 0; k < cn; k++ )
+            s[k] = sq[k] = 0;
+        for( int i = 0; i < n; i++, sums += cn*2 )
+        {
+            nz0 += nz[i];
+            for( k = 0; k < cn; k++ )
+            {
+                s[k] += sums[k];
+                sq[k] += sums[k + cn];
+            }
+        }
+    }
+    else
+        nz0 = sumSqr( src, mask, s, sq );
+
     double scale = nz0 ? 1./nz0 : 0.;
     for( k = 0; k < cn; k++ )
     {
@@ -2319,20 +2468,16 @@ static bool ipp_minMaxIdx( Mat &src, double* minVal, double* maxVal, int* minIdx
 
 }
 
-void cv::minMaxIdx(InputArray _src, double* minVal,
-                   double* maxVal, int* minIdx, int* maxIdx,
-                   InputArray _mask)
+namespace cv
 {
-    int type = _src.type(), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
-    CV_Assert( (cn == 1 && (_mask.empty() || _mask.type() == CV_8U)) ||
-        (cn > 1 && _mask.empty() && !minIdx && !maxIdx) );
-
-    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2  && (_mask.empty() || _src.size() == _mask.size()),
-               ocl_minMaxIdx(_src, minVal, maxVal, minIdx, maxIdx, _mask))
-
-    Mat src = _src.getMat(), mask = _mask.getMat();
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_minMaxIdx(src, minVal, maxVal, minIdx, maxIdx, mask))
 
+// Finds the extrema of the elements of src selected by mask. minidx and maxidx are set to the
+// one-based offsets of their first occurrences, counted from ofs, or to 0 if there are none;
+// minval and maxval are then left at the initial values of the search.
+static void minMaxIdxMat( const Mat& src, const Mat& mask, size_t ofs,
+                          double* minval, double* maxval, size_t* minidx, size_t* maxidx )
+{
+    int depth = src.depth(), cn = src.channels();
     MinMaxIdxFunc func = getMinmaxTab(depth);
     CV_Assert( func != 0 );
 
@@ -2340,21 +2485,95 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
     uchar* ptrs[2];
     NAryMatIterator it(arrays, ptrs);
 
-    size_t minidx = 0, maxidx = 0;
     int iminval = INT_MAX, imaxval = INT_MIN;
     float  fminval = std::numeric_limits<float>::infinity(),  fmaxval = -fminval;
     double dminval = std::numeric_limits<double>::infinity(), dmaxval = -dminval;
-    size_t startidx = 1;
-    int *minval = &iminval, *maxval = &imaxval;
+    size_t startidx = ofs + 1;
+    int *pminval = &iminval, *pmaxval = &imaxval;
     int planeSize = (int)it.size*cn;
 
     if( depth == CV_32F )
-        minval = (int*)&fminval, maxval = (int*)&fmaxval;
+        pminval = (int*)&fminval, pmaxval = (int*)&fmaxval;
     else if( depth == CV_64F )
-        minval = (int*)&dminval, maxval = (int*)&dmaxval;
+        pminval = (int*)&dminval, pmaxval = (int*)&dmaxval;
 
+    *minidx = *maxidx = 0;
     for( size_t i = 0; i < it.nplanes; i++, ++it, startidx += planeSize )
-        func( ptrs[0], ptrs[1], minval, maxval, &minidx, &maxidx, planeSize, startidx );
+        func( ptrs[0], ptrs[1], pminval, pmaxval, minidx, maxidx, planeSize, startidx );
+
+    if( depth == CV_32F )
+        dminval = fminval, dmaxval = fmaxval;
+    else if( depth <= CV_32S )
+        dminval = iminval, dmaxval = imaxval;
+    *minval = dminval;
+    *maxval = dmaxval;
+}
+
+class MinMaxIdxInvoker : public ParallelLoopBody
+{
+public:
+    MinMaxIdxInvoker( const ReduceStripes& _stripes, double* _vals, size_t* _idx )
+        : stripes(_stripes), vals(_vals), idx(_idx) {}
+
+    void operator()( const Range& range ) const
+    {
+        Mat src, mask;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            size_t ofs = stripes.get( i, src, mask );
+            minMaxIdxMat( src, mask, ofs*src.channels(), vals + i*2, vals + i*2 + 1,
+                          idx + i*2, idx + i*2 + 1 );
+        }
+    }
+
+protected:
+    const ReduceStripes& stripes;
+    double* vals;
+    size_t* idx;
+};
+
+}
+
+void cv::minMaxIdx(InputArray _src, double* minVal,
+                   double* maxVal, int* minIdx, int* maxIdx,
+                   InputArray _mask)
+{
+    int type = _src.type(), cn = CV_MAT_CN(type);
+    CV_Assert( (cn == 1 && (_mask.empty() || _mask.type() == CV_8U)) ||
+        (cn > 1 && _mask.empty() && !minIdx && !maxIdx) );
+
+    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2  && (_mask.empty() || _src.size() == _mask.size()),
+               ocl_minMaxIdx(_src, minVal, maxVal, minIdx, maxIdx, _mask))
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_minMaxIdx(src, minVal, maxVal, minIdx, maxIdx, mask))
+
+    size_t minidx = 0, maxidx = 0;
+    double dminval = 0, dmaxval = 0;
+
+    ReduceStripes stripes( src, mask );
+    if( stripes.count() > 1 )
+    {
+        int n = stripes.count();
+        AutoBuffer<double> _vals(n*2);
+        AutoBuffer<size_t> _idx(n*2);
+        double* vals = _vals;
+        size_t* idx = _idx;
+        parallel_for_( Range(0, n), MinMaxIdxInvoker(stripes, vals, idx) );
+
+        // the first stripe holding the extremum wins, like in a serial scan
+        dminval = vals[0], dmaxval = vals[1];
+        minidx = idx[0], maxidx = idx[1];
+        for( int i = 1; i < n; i++ )
+        {
+            if( idx[i*2] && (minidx == 0 || vals[i*2] < dminval) )
+                dminval = vals[i*2], minidx = idx[i*2];
+            if( idx[i*2+1] && (maxidx == 0 || vals[i*2+1] > dmaxval) )
+                dmaxval = vals[i*2+1], maxidx = idx[i*2+1];
+        }
+    }
+    else
+        minMaxIdxMat( src, mask, 0, &dminval, &dmaxval, &minidx, &maxidx );
 
     if (!src.empty() && mask.empty())
     {
@@ -2366,10 +2585,6 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
 
     if( minidx == 0 )
         dminval = dmaxval = 0;
-    else if( depth == CV_32F )
-        dminval = fminval, dmaxval = fmaxval;
-    else if( depth <= CV_32S )
-        dminval = iminval, dmaxval = imaxval;
 
     if( minVal )
         *minVal = dminval;
@@ -2394,6 +2609,171 @@ void cv::minMaxLoc( InputArray _img, double* minVal, double* maxVal,
         std::swap(maxLoc->x, maxLoc->y);
 }
 
+/****************************************************************************************\
+*                                   computeArrayStats                                    *
+\****************************************************************************************/
+
+namespace cv
+{
+
+struct ArrayStatsPartial
+{
+    int count;
+    double sum[4], sqsum[4], abssum;
+    double minVal, maxVal;
+    Point minLoc, maxLoc;
+};
+
+// WT accumulates the sums of a whole stripe exactly for the integer types
+template<typename T, typename WT> static void
+arrayStats_( const Mat& src, const Mat& mask, int y0, ArrayStatsPartial& p )
+{
+    typedef std::numeric_limits<T> limits;
+    int x, y, c, cn = src.channels(), width = src.cols, count = 0;
+    WT s[4] = {0, 0, 0, 0}, sq[4] = {0, 0, 0, 0}, as = 0;
+    T minv = limits::has_infinity ? limits::infinity() : limits::max();
+    T maxv = limits::has_infinity ? -limits::infinity() : limits::min();
+    Point minLoc(-1, -1), maxLoc(-1, -1), first(-1, -1);
+
+    for( y = 0; y < src.rows; y++ )
+    {
+        const T* row = src.ptr<T>(y);
+        const uchar* m = mask.data ? mask.ptr(y) : 0;
+        for( x = 0; x < width; x++, row += cn )
+        {
+            if( m && !m[x] )
+                continue;
+            if( count++ == 0 )
+                first = Point(x, y0 + y);
+            for( c = 0; c < cn; c++ )
+            {
+                T v = row[c];
+                s[c] += v;
+                sq[c] += (WT)v*v;
+                as += v < 0 ? -(WT)v : (WT)v;
+                if( v < minv )
+                    minv = v, minLoc = Point(x, y0 + y);
+                if( v > maxv )
+                    maxv = v, maxLoc = Point(x, y0 + y);
+            }
+        }
+    }
+
+    // all the values were NaN or equal to the initial ones
+    if( count > 0 && minLoc.x < 0 )
+        minLoc = first;
+    if( count > 0 && maxLoc.x < 0 )
+        maxLoc = first;
+
+    p.count = count;
+    for( c = 0; c < 4; c++ )
+    {
+        p.sum[c] = (double)s[c];
+        p.sqsum[c] = (double)sq[c];
+    }
+    p.abssum = (double)as;
+    p.minVal = (double)minv;
+    p.maxVal = (double)maxv;
+    p.minLoc = minLoc;
+    p.maxLoc = maxLoc;
+}
+
+typedef void (*ArrayStatsFunc)( const Mat& src, const Mat& mask, int y0, ArrayStatsPartial& p );
+
+static ArrayStatsFunc getArrayStatsFunc( int depth )
+{
+    static ArrayStatsFunc tab[] =
+    {
+        arrayStats_<uchar, int64>, arrayStats_<schar, int64>, arrayStats_<ushort, int64>,
+        arrayStats_<short, int64>, arrayStats_<int, double>, arrayStats_<float, double>,
+        arrayStats_<double, double>, 0
+    };
+    return tab[depth];
+}
+
+// the extrema are tracked per stripe, so the array is cut into ranges of whole rows
+class ArrayStatsInvoker : public ParallelLoopBody
+{
+public:
+    ArrayStatsInvoker( const Mat& _src, const Mat& _mask, ArrayStatsFunc _func,
+                       ArrayStatsPartial* _partials, int _nstripes )
+        : src(_src), mask(_mask), func(_func), partials(_partials), nstripes(_nstripes) {}
+
+    void operator()( const Range& range ) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            int y0 = (int)((int64)src.rows*i/nstripes), y1 = (int)((int64)src.rows*(i+1)/nstripes);
+            func( src.rowRange(y0, y1), mask.empty() ? Mat() : mask.rowRange(y0, y1), y0, partials[i] );
+        }
+    }
+
+protected:
+    Mat src, mask;
+    ArrayStatsFunc func;
+    ArrayStatsPartial* partials;
+    int nstripes;
+};
+
+}
+
+cv::ArrayStats::ArrayStats()
+    : count(0), minVal(0), maxVal(0), minLoc(-1, -1), maxLoc(-1, -1), normInf(0), normL1(0), normL2(0)
+{
+}
+
+void cv::computeArrayStats( InputArray _src, ArrayStats& stats, InputArray _mask )
+{
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    int k, cn = src.channels();
+    CV_Assert( src.dims <= 2 && cn <= 4 );
+    CV_Assert( mask.empty() || (mask.type() == CV_8UC1 && mask.size == src.size) );
+
+    ArrayStatsFunc func = getArrayStatsFunc( src.depth() );
+    CV_Assert( func != 0 );
+
+    int n = (int)std::min( src.total()/REDUCE_STRIPE_SIZE, (size_t)src.rows );
+    std::vector<ArrayStatsPartial> partials( std::max(n, 1) );
+    if( n > 1 )
+        parallel_for_( Range(0, n), ArrayStatsInvoker(src, mask, func, &partials[0], n) );
+    else
+        func( src, mask, 0, partials[0] );
+
+    // the first stripe holding an extremum wins, like in a serial scan
+    stats = ArrayStats();
+    double sqsum[4] = {0, 0, 0, 0};
+    for( size_t i = 0; i < partials.size(); i++ )
+    {
+        const ArrayStatsPartial& p = partials[i];
+        if( p.count == 0 )
+            continue;
+        if( stats.count == 0 || p.minVal < stats.minVal )
+            stats.minVal = p.minVal, stats.minLoc = p.minLoc;
+        if( stats.count == 0 || p.maxVal > stats.maxVal )
+            stats.maxVal = p.maxVal, stats.maxLoc = p.maxLoc;
+        stats.count += p.count;
+        for( k = 0; k < cn; k++ )
+        {
+            stats.sum[k] += p.sum[k];
+            sqsum[k] += p.sqsum[k];
+        }
+        stats.normL1 += p.abssum;
+    }
+
+    if( stats.count == 0 )
+        return;
+
+    double scale = 1./stats.count;
+    for( k = 0; k < cn; k++ )
+    {
+        stats.mean[k] = stats.sum[k]*scale;
+        stats.stddev[k] = std::sqrt(std::max(sqsum[k]*scale - stats.mean[k]*stats.mean[k], 0.));
+        stats.normL2 += sqsum[k];
+    }
+    stats.normL2 = std::sqrt(stats.normL2);
+    stats.normInf = std::max(std::abs(stats.minVal), std::abs(stats.maxVal));
+}
+
 /****************************************************************************************\
 *                                         norm                                           *
 \****************************************************************************************/
@@ -2838,6 +3218,33 @@ static bool ipp_norm(Mat &src, int normType, Mat &mask, double &result)
 #endif
 }
 
+namespace cv
+{
+
+class NormInvoker : public ParallelLoopBody
+{
+public:
+    NormInvoker( const ReduceStripes& _stripes, int _normType, double* _norms )
+        : stripes(_stripes), normType(_normType), norms(_norms) {}
+
+    void operator()( const Range& range ) const
+    {
+        Mat src, mask;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            stripes.get( i, src, mask );
+            norms[i] = norm( src, normType, mask );
+        }
+    }
+
+protected:
+    const ReduceStripes& stripes;
+    int normType;
+    double* norms;
+};
+
+}
+
 double cv::norm( InputArray _src, int normType, InputArray _mask )
 {
     normType &= NORM_TYPE_MASK;
@@ -2858,6 +3265,22 @@ double cv::norm( InputArray _src, int normType, InputArray _mask )
     Mat src = _src.getMat(), mask = _mask.getMat();
     CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(src, normType, mask, _result), _result);
 
+    if( normType != NORM_HAMMING && normType != NORM_HAMMING2 )
+    {
+        ReduceStripes stripes( src, mask );
+        if( stripes.count() > 1 )
+        {
+            // the partial L2 norms are merged as squares
+            int stripeNormType = normType == NORM_L2 ? NORM_L2SQR : normType;
+            std::vector<double> norms( stripes.count() );
+            parallel_for_( Range(0, stripes.count()), NormInvoker(stripes, stripeNormType, &norms[0]) );
+            double result = 0;
+            for( int i = 0; i < stripes.count(); i++ )
+                result = normType == NORM_INF ? std::max(result, norms[i]) : result + norms[i];
+            return normType == NORM_L2 ? std::sqrt(result) : result;
+        }
+    }
+
     int depth = src.depth(), cn = src.channels();
     if( src.isContinuous() && mask.empty() )
     {
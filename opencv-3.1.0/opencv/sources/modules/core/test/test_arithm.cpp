@@ -1833,3 +1833,160 @@ TEST(MinMaxLoc, Mat_IntMax_Without_Mask)
     ASSERT_EQ(Point(0, 0), minLoc);
     ASSERT_EQ(Point(0, 0), maxLoc);
 }
+
+TEST(Core_ArrayStats, accuracy)
+{
+    const int depths[] = { CV_8U, CV_8S, CV_16U, CV_16S, CV_32S, CV_32F, CV_64F };
+    const Size sizes[] = { Size(23, 17), Size(640, 480) };
+    RNG& rng = theRNG();
+
+    for( int d = 0; d < 7; d++ )
+    for( int cn = 1; cn <= 3; cn += 2 )
+    for( int s = 0; s < 2; s++ )
+    for( int masked = 0; masked < 2; masked++ )
+    {
+        SCOPED_TRACE(cv::format("depth=%d cn=%d size=%dx%d mask=%d", depths[d], cn, sizes[s].width, sizes[s].height, masked));
+        Mat src(sizes[s], CV_MAKETYPE(depths[d], cn)), mask;
+        rng.fill(src, RNG::UNIFORM, -100, 100);
+        if( masked )
+        {
+            mask.create(src.size(), CV_8U);
+            rng.fill(mask, RNG::UNIFORM, 0, 2);
+        }
+
+        ArrayStats stats;
+        computeArrayStats(src, stats, mask);
+
+        Mat mean, sdv;
+        meanStdDev(src, mean, sdv, mask);
+        int count = masked ? countNonZero(mask) : (int)src.total();
+        EXPECT_EQ(count, stats.count);
+        for( int c = 0; c < cn; c++ )
+        {
+            EXPECT_NEAR(mean.at<double>(c), stats.mean[c], 1e-6);
+            EXPECT_NEAR(sdv.at<double>(c), stats.stddev[c], 1e-6);
+            EXPECT_NEAR(mean.at<double>(c)*count, stats.sum[c], 1e-6*count);
+        }
+
+        double minVal, maxVal;
+        Point minLoc, maxLoc;
+        if( cn == 1 )
+            minMaxLoc(src, &minVal, &maxVal, &minLoc, &maxLoc, mask);
+        else
+        {
+            // the location of the first element holding the extremum in any channel
+            minMaxLoc(src.reshape(1), &minVal, &maxVal, &minLoc, &maxLoc);
+            minLoc.x /= cn;
+            maxLoc.x /= cn;
+        }
+        if( !masked || cn == 1 )
+        {
+            EXPECT_EQ(minVal, stats.minVal);
+            EXPECT_EQ(maxVal, stats.maxVal);
+            EXPECT_EQ(minLoc, stats.minLoc);
+            EXPECT_EQ(maxLoc, stats.maxLoc);
+        }
+
+        double scale = (double)src.total()*cn;
+        EXPECT_NEAR(norm(src, NORM_INF, mask), stats.normInf, 1e-6);
+        EXPECT_NEAR(norm(src, NORM_L1, mask), stats.normL1, 1e-6*scale);
+        EXPECT_NEAR(norm(src, NORM_L2, mask), stats.normL2, 1e-6*std::sqrt(scale));
+    }
+
+    ArrayStats stats;
+    Mat zeros = Mat::zeros(10, 10, CV_8U);
+    computeArrayStats(Mat::ones(10, 10, CV_32F), stats, zeros);
+    EXPECT_EQ(0, stats.count);
+    EXPECT_EQ(Point(-1, -1), stats.minLoc);
+    EXPECT_EQ(0, stats.normL2);
+}
+
+TEST(Core_ParallelReduce, matches_serial)
+{
+    RNG& rng = theRNG();
+    Mat big(1000, 700, CV_32FC2), roi;
+    rng.fill(big, RNG::UNIFORM, -1000, 1000);
+    roi = big(Rect(3, 5, 650, 990));
+    Mat mask(roi.size(), CV_8U);
+    rng.fill(mask, RNG::UNIFORM, 0, 2);
+
+    // the extremum appears in two stripes, the first one must be reported
+    Mat plane = big.reshape(1);
+    plane.at<float>(700, 101) = plane.at<float>(100, 101) = -5000.f;
+    plane.at<float>(900, 11) = plane.at<float>(300, 11) = 5000.f;
+
+    const Mat arrays[] = { big, roi, big.reshape(1) };
+    for( int k = 0; k < 3; k++ )
+    {
+        SCOPED_TRACE(k);
+        const Mat& src = arrays[k];
+        Mat src1 = src.reshape(1);
+
+        // the same reductions, row by row
+        Scalar s;
+        double l1 = 0, l2 = 0, inf = 0;
+        for( int y = 0; y < src.rows; y++ )
+        {
+            s += sum(src.row(y));
+            l1 += norm(src.row(y), NORM_L1);
+            l2 += norm(src.row(y), NORM_L2SQR);
+            inf = std::max(inf, norm(src.row(y), NORM_INF));
+        }
+        Scalar s1 = sum(src);
+        for( int c = 0; c < 4; c++ )
+            EXPECT_NEAR(s[c], s1[c], 1e-9*src.total()*1000);
+        EXPECT_NEAR(l1, norm(src, NORM_L1), 1e-9*l1);
+        EXPECT_NEAR(std::sqrt(l2), norm(src, NORM_L2), 1e-9*std::sqrt(l2));
+        EXPECT_EQ(inf, norm(src, NORM_INF));
+
+        double minVal, maxVal;
+        Point minLoc, maxLoc;
+        minMaxLoc(src1, &minVal, &maxVal, &minLoc, &maxLoc);
+        EXPECT_EQ(-5000., minVal);
+        EXPECT_EQ(5000., maxVal);
+        if( k != 1 )
+        {
+            EXPECT_EQ(Point(101, 100), minLoc);
+            EXPECT_EQ(Point(11, 300), maxLoc);
+        }
+        else
+        {
+            EXPECT_EQ(Point(101 - 6, 100 - 5), minLoc);
+            EXPECT_EQ(Point(11 - 6, 300 - 5), maxLoc);
+        }
+
+        // the merged result does not depend on the number of threads
+        int nthreads = getNumThreads();
+        Mat mean, sdv, mean1, sdv1;
+        meanStdDev(src, mean, sdv);
+        setNumThreads(1);
+        Scalar s2 = sum(src);
+        meanStdDev(src, mean1, sdv1);
+        setNumThreads(nthreads);
+        EXPECT_EQ(s1, s2);
+        EXPECT_EQ(0, cvtest::norm(mean, mean1, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(sdv, sdv1, NORM_INF));
+    }
+
+    // masked statistics against the same computation on a copy of the selected elements
+    Mat roi1 = roi.reshape(1).colRange(0, 1), selected;
+    roi1.copyTo(selected, mask);
+    Mat mean, sdv;
+    meanStdDev(roi1, mean, sdv, mask);
+    double minVal, maxVal;
+    minMaxLoc(roi1, &minVal, &maxVal, 0, 0, mask);
+    double s = 0, sq = 0, minRef = DBL_MAX, maxRef = -DBL_MAX;
+    int n = 0;
+    for( int y = 0; y < roi1.rows; y++ )
+        if( mask.at<uchar>(y, 0) )
+        {
+            double v = roi1.at<float>(y, 0);
+            s += v, sq += v*v, n++;
+            minRef = std::min(minRef, v), maxRef = std::max(maxRef, v);
+        }
+    EXPECT_NEAR(s/n, mean.at<double>(0), 1e-6);
+    EXPECT_NEAR(std::sqrt(sq/n - (s/n)*(s/n)), sdv.at<double>(0), 1e-6);
+    EXPECT_EQ(minRef, minVal);
+    EXPECT_EQ(maxRef, maxVal);
+    EXPECT_NEAR(norm(roi, NORM_L2, mask), norm(roi.clone(), NORM_L2, mask), 1e-6*norm(roi, NORM_L2, mask));
+}
@@ -887,3 +887,61 @@ TEST(Core_DFT, complex_output2)
         }
     }
 }
+
+TEST(Core_DFT, mixed_radix_32f)
+{
+    // lengths with radix 2, 3, 4, 5 and generic factors, compared against the double precision transform
+    const int sizes[] = { 6, 10, 12, 15, 30, 45, 60, 75, 100, 105, 120, 243, 250, 625, 1000, 1024, 1080 };
+    RNG& rng = theRNG();
+    for( size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++ )
+    {
+        for( int k = 0; k < 4; k++ )
+        {
+            int n = sizes[i], cn = k & 1 ? 2 : 1, flags = k & 2 ? DFT_INVERSE : 0;
+            Mat src(3, n, CV_MAKETYPE(CV_64F, cn)), src32f, dst, dst32f;
+            rng.fill(src, RNG::UNIFORM, -1., 1.);
+            src.convertTo(src32f, CV_32F);
+            if( cn == 1 && (flags & DFT_INVERSE) )
+            {
+                // the inverse transform of a CCS-packed spectrum is real
+                dft(src, src, DFT_ROWS);
+                src.convertTo(src32f, CV_32F);
+                flags |= DFT_REAL_OUTPUT;
+            }
+            dft(src, dst, flags | DFT_ROWS);
+            dft(src32f, dst32f, flags | DFT_ROWS);
+            dst.convertTo(dst, CV_32F);
+            ASSERT_LT(cvtest::norm(dst32f, dst, NORM_INF | NORM_RELATIVE), 1e-5) << "n=" << n << ", k=" << k;
+        }
+    }
+}
+
+TEST(Core_DFT, threads_consistency)
+{
+    // rows and columns are transformed in parallel; the result must not depend on the number of threads
+    const int types[] = { CV_32FC1, CV_32FC2, CV_64FC1, CV_64FC2 };
+    const Size sizes[] = { Size(64, 48), Size(90, 75), Size(31, 17), Size(1, 100), Size(100, 1) };
+    int nthreads = getNumThreads();
+    for( size_t t = 0; t < sizeof(types)/sizeof(types[0]); t++ )
+        for( size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++ )
+        {
+            Mat src(sizes[s], types[t]), dst1, dst4, dct1, dct4;
+            randu(src, -1., 1.);
+            bool dct_ok = CV_MAT_CN(types[t]) == 1 && src.cols % 2 == 0 && src.rows % 2 == 0;
+            int nonzero_rows = src.cols > 1 ? src.rows/2 : 0;
+
+            setNumThreads(1);
+            dft(src, dst1, 0, nonzero_rows);
+            if( dct_ok )
+                dct(src, dct1);
+            setNumThreads(4);
+            dft(src, dst4, 0, nonzero_rows);
+            if( dct_ok )
+                dct(src, dct4);
+            setNumThreads(nthreads);
+
+            ASSERT_EQ(0, cvtest::norm(dst1, dst4, NORM_INF)) << "type=" << types[t] << ", size=" << sizes[s];
+            if( dct_ok )
+                ASSERT_EQ(0, cvtest::norm(dct1, dct4, NORM_INF)) << "type=" << types[t] << ", size=" << sizes[s];
+        }
+}
@@ -412,3 +412,33 @@ TEST(Core_Eigen, scalar_32) {Core_EigenTest_Scalar_32 test; test.safe_run(); }
 TEST(Core_Eigen, scalar_64) {Core_EigenTest_Scalar_64 test; test.safe_run(); }
 TEST(Core_Eigen, vector_32) { Core_EigenTest_32 test; test.safe_run(); }
 TEST(Core_Eigen, vector_64) { Core_EigenTest_64 test; test.safe_run(); }
+
+TEST(Core_Eigen, householder_ql_vs_jacobi)
+{
+    // the two diagonal blocks are small enough for the Jacobi method,
+    // the whole matrix goes through the tridiagonalization
+    cv::RNG& rng = cv::theRNG();
+    for( int type = CV_32F; type <= CV_64F; type++ )
+        for( int iter = 0; iter < 5; iter++ )
+        {
+            int n0 = rng.uniform(16, 32), n1 = rng.uniform(16, 32), n = n0 + n1;
+            cv::Mat a0(n0, n0, type), a1(n1, n1, type), a = cv::Mat::zeros(n, n, type);
+            rng.fill(a0, cv::RNG::UNIFORM, -1, 1);
+            rng.fill(a1, cv::RNG::UNIFORM, -1, 1);
+            cv::Mat(a0 + a0.t()).copyTo(a(cv::Rect(0, 0, n0, n0)));
+            cv::Mat(a1 + a1.t()).copyTo(a(cv::Rect(n0, n0, n1, n1)));
+
+            cv::Mat e0, e1, eref, evals, evects;
+            cv::eigen(a(cv::Rect(0, 0, n0, n0)), e0);
+            cv::eigen(a(cv::Rect(n0, n0, n1, n1)), e1);
+            cv::vconcat(e0, e1, eref);
+            cv::sort(eref, eref, cv::SORT_EVERY_COLUMN + cv::SORT_DESCENDING);
+            cv::eigen(a, evals, evects);
+
+            double eps = type == CV_32F ? 1e-5 : 1e-12;
+            double scale = cv::norm(eref, cv::NORM_INF);
+            ASSERT_LE(cvtest::norm(evals, eref, cv::NORM_INF), eps*scale);
+            ASSERT_LE(cvtest::norm(evects*evects.t(), cv::Mat::eye(n, n, type), cv::NORM_INF), eps*n);
+            ASSERT_LE(cvtest::norm(evects*a, cv::Mat::diag(evals)*evects, cv::NORM_INF), eps*n*scale);
+        }
+}
@@ -566,3 +566,282 @@ TEST(Core_InputOutput, FileStorage)
     sprintf(arr, "sprintf is hell %d", 666);
     EXPECT_NO_THROW(f << arr);
 }
+
+TEST(Core_InputOutput, FileStorage_sidecar)
+{
+    const char* exts[] = { ".xml", ".yml" };
+    for( int k = 0; k < 2; k++ )
+    {
+        std::string file = cv::tempfile(exts[k]), sidecar = file + ".raw";
+        RNG& rng = theRNG();
+
+        Mat big(300, 200, CV_32FC3), small(3, 3, CV_64F), roi_src(100, 300, CV_16S), nd;
+        int nd_sizes[] = { 20, 30, 40 };
+        nd.create(3, nd_sizes, CV_8U);
+        rng.fill(big, RNG::UNIFORM, -100, 100);
+        rng.fill(small, RNG::UNIFORM, -100, 100);
+        rng.fill(roi_src, RNG::UNIFORM, -1000, 1000);
+        rng.fill(nd, RNG::UNIFORM, 0, 256);
+        Mat roi = roi_src.colRange(50, 250);
+
+        {
+            FileStorage fs(file, FileStorage::WRITE + FileStorage::BINARY_SIDECAR);
+            ASSERT_TRUE(fs.isOpened());
+            fs << "big" << big << "small" << small << "roi" << roi << "nd" << nd;
+            fs << "value" << 5;
+        }
+
+        // only the big matrices went to the sidecar, each starting at an aligned offset
+        {
+            FILE* f = fopen(sidecar.c_str(), "rb");
+            ASSERT_TRUE(f != 0);
+            fseek(f, 0, SEEK_END);
+            long size = ftell(f);
+            fclose(f);
+            EXPECT_GE(size, (long)(big.total()*big.elemSize() + roi.total()*roi.elemSize() + nd.total()));
+        }
+
+        Mat big1, small1, roi1, nd1;
+        {
+            FileStorage fs(file, FileStorage::READ);
+            ASSERT_TRUE(fs.isOpened());
+            EXPECT_TRUE(fs["small"]["raw_offset"].empty());
+            EXPECT_FALSE(fs["big"]["raw_offset"].empty());
+            fs["big"] >> big1;
+            fs["small"] >> small1;
+            fs["roi"] >> roi1;
+            fs["nd"] >> nd1;
+            EXPECT_EQ(5, (int)fs["value"]);
+        }
+        // the matrices outlive the storage
+        EXPECT_EQ(0, cvtest::norm(big, big1, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(small, small1, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(roi, roi1, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(nd, nd1, NORM_INF));
+        EXPECT_EQ(0u, (size_t)big1.data % 64);
+
+        // the mapping is private, so modifying a matrix does not change the file
+        big1.setTo(Scalar::all(0));
+        {
+            FileStorage fs(file, FileStorage::READ + FileStorage::VERIFY_SIDECAR);
+            Mat big2;
+            fs["big"] >> big2;
+            EXPECT_EQ(0, cvtest::norm(big, big2, NORM_INF));
+
+            // the C API reads a copy
+            CvMat* m = (CvMat*)cvRead(*fs, cvGetFileNodeByName(*fs, 0, "roi"));
+            ASSERT_TRUE(m != 0);
+            EXPECT_EQ(0, cvtest::norm(roi, cvarrToMat(m), NORM_INF));
+            cvReleaseMat(&m);
+        }
+        big1.release();
+
+        // corrupt one byte of the big matrix
+        {
+            FILE* f = fopen(sidecar.c_str(), "r+b");
+            ASSERT_TRUE(f != 0);
+            fseek(f, 1000, SEEK_SET);
+            int c = fgetc(f);
+            fseek(f, 1000, SEEK_SET);
+            fputc(c ^ 0xff, f);
+            fclose(f);
+        }
+        {
+            FileStorage fs(file, FileStorage::READ + FileStorage::VERIFY_SIDECAR);
+            Mat big2;
+            EXPECT_THROW(fs["big"] >> big2, cv::Exception);
+            EXPECT_NO_THROW(fs["roi"] >> roi1);
+        }
+        {
+            FileStorage fs(file, FileStorage::READ);
+            Mat big2;
+            EXPECT_NO_THROW(fs["big"] >> big2);
+            EXPECT_NE(0, cvtest::norm(big, big2, NORM_INF));
+        }
+
+        remove(file.c_str());
+        remove(sidecar.c_str());
+    }
+}
+
+static void checkReaderEvent(FileStorageReader& reader, int e, const char* name, int depth)
+{
+    ASSERT_EQ(e, reader.next());
+    EXPECT_EQ(String(name), reader.name());
+    EXPECT_EQ(depth, reader.depth());
+}
+
+TEST(Core_InputOutput, FileStorageReader)
+{
+    const char* exts[] = { ".xml", ".yml", ".xml.gz", ".yml.gz" };
+    const String q = "a \"quoted\" <str> & 'x'";
+    for( int k = 0; k < 4; k++ )
+    {
+        SCOPED_TRACE(exts[k]);
+        std::string file = cv::tempfile(exts[k]);
+        RNG& rng = theRNG();
+
+        Mat m = (Mat_<float>(2, 3) << 1, 2, 3, 4, 5, 6), big(30, 40, CV_64FC2), nd, one(1, 1, CV_32S, Scalar(-7));
+        int nd_sizes[] = { 3, 4, 5 };
+        nd.create(3, nd_sizes, CV_16S);
+        rng.fill(big, RNG::UNIFORM, -100, 100);
+        rng.fill(nd, RNG::UNIFORM, -1000, 1000);
+        big.at<Vec2d>(0, 0) = Vec2d(std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
+        {
+            FileStorage fs(file, FileStorage::WRITE);
+            ASSERT_TRUE(fs.isOpened());
+            fs << "i" << 5 << "s" << "hello world" << "q" << q << "e" << "";
+            fs << "m" << m << "big" << big << "nd" << nd << "one" << one;
+            fs << "seq" << "[" << 1 << 2.5 << "str" << "[" << 1 << 2 << "]"
+               << "{" << "a" << 1 << "b" << "[" << 3 << 4 << "]" << "}" << "]";
+            fs << "fmap" << "{:" << "x" << 1 << "y" << 2 << "}";
+            fs << "map" << "{" << "inner" << "{" << "z" << 3 << "}" << "emptyseq" << "[" << "]" << "}";
+            fs << "last" << 1;
+        }
+
+        FileStorageReader reader(file);
+        ASSERT_TRUE(reader.isOpened());
+        EXPECT_EQ(FileStorageReader::NONE, reader.event());
+
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "i", 0);
+        EXPECT_EQ(5., reader.real());
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "s", 0);
+        EXPECT_EQ(String("hello world"), reader.str());
+        EXPECT_THROW(reader.real(), cv::Exception);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "q", 0);
+        EXPECT_EQ(q, reader.str());
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "e", 0);
+        EXPECT_EQ(String(), reader.str());
+
+        Mat m1, big1, nd1, one1;
+        checkReaderEvent(reader, FileStorageReader::START_MAP, "m", 0);
+        EXPECT_EQ(String("opencv-matrix"), reader.typeName());
+        reader.readMat(m1);
+        EXPECT_EQ(FileStorageReader::END, reader.event());
+        EXPECT_EQ(0, reader.depth());
+        EXPECT_EQ(0, cvtest::norm(m, m1, NORM_INF));
+
+        // a matrix is parsed into the caller's buffer, even if it is not continuous
+        checkReaderEvent(reader, FileStorageReader::START_MAP, "big", 0);
+        Mat parent(30, 50, CV_64FC2, Scalar::all(0));
+        big1 = parent.colRange(5, 45);
+        reader.readMat(big1);
+        EXPECT_EQ(parent.ptr(0, 5), big1.data);
+        EXPECT_EQ(0, cvtest::norm(big, big1, NORM_INF));
+
+        checkReaderEvent(reader, FileStorageReader::START_MAP, "nd", 0);
+        EXPECT_EQ(String("opencv-nd-matrix"), reader.typeName());
+        reader.readMat(nd1);
+        EXPECT_EQ(0, cvtest::norm(nd, nd1, NORM_INF));
+
+        checkReaderEvent(reader, FileStorageReader::START_MAP, "one", 0);
+        reader.readMat(one1);
+        EXPECT_EQ(0, cvtest::norm(one, one1, NORM_INF));
+
+        checkReaderEvent(reader, FileStorageReader::START_SEQ, "seq", 0);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "", 1);
+        EXPECT_EQ(1., reader.real());
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "", 1);
+        EXPECT_EQ(2.5, reader.real());
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "", 1);
+        EXPECT_EQ(String("str"), reader.str());
+        checkReaderEvent(reader, FileStorageReader::START_SEQ, "", 1);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "", 2);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "", 2);
+        EXPECT_EQ(2., reader.real());
+        checkReaderEvent(reader, FileStorageReader::END, "", 1);
+        checkReaderEvent(reader, FileStorageReader::START_MAP, "", 1);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "a", 2);
+        checkReaderEvent(reader, FileStorageReader::START_SEQ, "b", 2);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "", 3);
+        EXPECT_EQ(3., reader.real());
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "", 3);
+        checkReaderEvent(reader, FileStorageReader::END, "", 2);
+        checkReaderEvent(reader, FileStorageReader::END, "", 1);
+        checkReaderEvent(reader, FileStorageReader::END, "", 0);
+
+        checkReaderEvent(reader, FileStorageReader::START_MAP, "fmap", 0);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "x", 1);
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "y", 1);
+        EXPECT_EQ(2., reader.real());
+        checkReaderEvent(reader, FileStorageReader::END, "", 0);
+
+        checkReaderEvent(reader, FileStorageReader::START_MAP, "map", 0);
+        reader.skip();
+        EXPECT_EQ(FileStorageReader::END, reader.event());
+        EXPECT_EQ(0, reader.depth());
+
+        checkReaderEvent(reader, FileStorageReader::SCALAR, "last", 0);
+        EXPECT_EQ(FileStorageReader::END_OF_STREAM, reader.next());
+        EXPECT_EQ(FileStorageReader::END_OF_STREAM, reader.next());
+
+        reader.release();
+        EXPECT_FALSE(reader.isOpened());
+        remove(file.c_str());
+    }
+
+    FileStorageReader reader;
+    EXPECT_FALSE(reader.open(cv::tempfile(".yml")));
+}
+
+TEST(Core_InputOutput, FileStorageReader_sidecar)
+{
+    const char* exts[] = { ".xml", ".yml" };
+    for( int k = 0; k < 2; k++ )
+    {
+        std::string file = cv::tempfile(exts[k]), sidecar = file + ".raw";
+        Mat big(100, 100, CV_32FC3), big1;
+        theRNG().fill(big, RNG::UNIFORM, -100, 100);
+        {
+            FileStorage fs(file, FileStorage::WRITE + FileStorage::BINARY_SIDECAR);
+            fs << "big" << big;
+        }
+
+        FileStorageReader reader(file);
+        ASSERT_EQ(FileStorageReader::START_MAP, reader.next());
+        reader.readMat(big1);
+        EXPECT_EQ(0, cvtest::norm(big, big1, NORM_INF));
+        EXPECT_EQ(FileStorageReader::END_OF_STREAM, reader.next());
+
+        // corrupt one byte of the data
+        {
+            FILE* f = fopen(sidecar.c_str(), "r+b");
+            ASSERT_TRUE(f != 0);
+            fseek(f, 1000, SEEK_SET);
+            int c = fgetc(f);
+            fseek(f, 1000, SEEK_SET);
+            fputc(c ^ 0xff, f);
+            fclose(f);
+        }
+        ASSERT_TRUE(reader.open(file));
+        ASSERT_EQ(FileStorageReader::START_MAP, reader.next());
+        EXPECT_THROW(reader.readMat(big1), cv::Exception);
+
+        remove(file.c_str());
+        remove(sidecar.c_str());
+    }
+}
+
+TEST(Core_InputOutput, FileStorageReader_errors)
+{
+    const char* docs[] =
+    {
+        "%YAML:1.0\na: 1\n  b: 2\n",
+        "%YAML:1.0\na: [ 1, 2\n",
+        "<?xml version=\"1.0\"?>\n<opencv_storage>\n<a>1</b>\n</opencv_storage>\n",
+        "<?xml version=\"1.0\"?>\n<opencv_storage>\n<a>1</a>\n"
+    };
+    for( int k = 0; k < 4; k++ )
+    {
+        std::string file = cv::tempfile(k < 2 ? ".yml" : ".xml");
+        FILE* f = fopen(file.c_str(), "wt");
+        ASSERT_TRUE(f != 0);
+        fputs(docs[k], f);
+        fclose(f);
+
+        FileStorageReader reader(file);
+        ASSERT_TRUE(reader.isOpened());
+        EXPECT_THROW(while( reader.next() != FileStorageReader::END_OF_STREAM ) {}, cv::Exception);
+        remove(file.c_str());
+    }
+}
@@ -1153,6 +1153,122 @@ TEST(Core_Array, basic_operations) { Core_ArrayOpTest test; test.safe_run(); }
 TEST(Core_Merge, shape_operations) { Core_MergeTest test; test.safe_run(); }
 TEST(Core_Split, shape_operations) { Core_SplitTest test; test.safe_run(); }
 
+// samples around a random offset with a few dominant, well separated directions
+static Mat makePCASamples(int count, int dims, RNG& rng)
+{
+    const float scales[] = { 20.f, 12.f, 8.f, 5.f, 3.f, 2.f };
+    const int rank = (int)(sizeof(scales)/sizeof(scales[0]));
+
+    Mat dirs(rank, dims, CV_32F), w, u, vt;
+    rng.fill(dirs, RNG::NORMAL, 0, 1);
+    SVD::compute(dirs, w, u, vt);
+
+    Mat coeffs(count, rank, CV_32F), offset(1, dims, CV_32F), samples(count, dims, CV_32F);
+    rng.fill(coeffs, RNG::NORMAL, 0, 1);
+    for( int j = 0; j < rank; j++ )
+        coeffs.col(j) *= scales[j];
+    rng.fill(offset, RNG::UNIFORM, -10, 10);
+    rng.fill(samples, RNG::NORMAL, 0, 0.1);
+    gemm(coeffs, vt, 1, samples, 1, samples);
+    samples += repeat(offset, count, 1);
+    return samples;
+}
+
+static void checkPCAComponents(const PCA& ref, const PCA& pca, int k, double valEps, double vecEps)
+{
+    ASSERT_GE(pca.eigenvectors.rows, k);
+    EXPECT_LE(cvtest::norm(ref.mean, pca.mean, NORM_INF), 1e-3);
+    for( int i = 0; i < k; i++ )
+    {
+        double lref = ref.eigenvalues.at<float>(i), l = pca.eigenvalues.at<float>(i);
+        EXPECT_LE(fabs(l - lref), lref*valEps) << "component " << i;
+        EXPECT_GE(fabs(ref.eigenvectors.row(i).dot(pca.eigenvectors.row(i))), 1 - vecEps) << "component " << i;
+    }
+}
+
+TEST(Core_PCA, randomized)
+{
+    RNG rng(0x1234);
+    theRNG().state = 0x4321;
+    Mat samples = makePCASamples(3000, 80, rng);
+
+    PCA ref(samples, noArray(), PCA::DATA_AS_ROW, 6);
+    PCA rpca(samples, noArray(), PCA::DATA_AS_ROW | PCA::RANDOMIZED, 6);
+    ASSERT_EQ(6, rpca.eigenvectors.rows);
+    checkPCAComponents(ref, rpca, 6, 1e-3, 1e-4);
+
+    Mat tsamples = samples.t();
+    PCA cpca(tsamples, noArray(), PCA::DATA_AS_COL | PCA::RANDOMIZED, 6);
+    ASSERT_EQ(Size(1, 80), cpca.mean.size());
+    EXPECT_LE(cvtest::norm(rpca.mean, cpca.mean.t(), NORM_INF), 1e-4);
+    // the components may differ in sign, so compare the reconstructions
+    Mat rrec = rpca.backProject(rpca.project(samples.rowRange(0, 10)));
+    Mat crec = cpca.backProject(cpca.project(tsamples.colRange(0, 10)));
+    EXPECT_LE(cvtest::norm(rrec.t(), crec, NORM_INF), 1e-2);
+    EXPECT_LE(cvtest::norm(rrec, samples.rowRange(0, 10), NORM_INF), 1.);
+}
+
+TEST(Core_PCA, incremental_update)
+{
+    RNG rng(0x5678);
+    const int count = 2000, dims = 64, batch = 500;
+    Mat samples = makePCASamples(count, dims, rng);
+    PCA ref(samples, noArray(), PCA::DATA_AS_ROW);
+
+    // keeping every component makes the update exact
+    PCA full, top, cols;
+    for( int i = 0; i < count; i += batch )
+    {
+        Mat rows = samples.rowRange(i, i + batch);
+        full.update(rows, PCA::DATA_AS_ROW, dims);
+        top.update(rows, PCA::DATA_AS_ROW, 6);
+        cols.update(rows.t(), PCA::DATA_AS_COL, dims);
+    }
+    EXPECT_EQ(count, full.samples);
+    ASSERT_EQ(dims, full.eigenvectors.rows);
+    checkPCAComponents(ref, full, 6, 1e-4, 1e-5);
+    EXPECT_LE(cvtest::norm(ref.eigenvalues, full.eigenvalues, NORM_INF), 1e-3);
+
+    // truncated models only lose the noise directions
+    ASSERT_EQ(6, top.eigenvectors.rows);
+    checkPCAComponents(ref, top, 6, 1e-2, 1e-4);
+
+    ASSERT_EQ(Size(1, dims), cols.mean.size());
+    EXPECT_LE(cvtest::norm(full.mean, cols.mean.t(), NORM_INF), 1e-4);
+    EXPECT_LE(cvtest::norm(full.eigenvalues, cols.eigenvalues, NORM_INF), 1e-3);
+}
+
+
+TEST(Core_Reduce, parallel_stripes)
+{
+    Mat src(600, 500, CV_32FC3), roi;
+    randu(src, -100, 100);
+    roi = src(Rect(7, 3, 480, 590));
+    const int ops[] = { REDUCE_SUM, REDUCE_AVG, REDUCE_MAX, REDUCE_MIN };
+
+    for( int k = 0; k < 4; k++ )
+    {
+        SCOPED_TRACE(k);
+        Mat rows, cols;
+        reduce(roi, rows, 0, ops[k], CV_64F);
+        reduce(roi, cols, 1, ops[k], CV_64F);
+
+        // the same reduction over small pieces that are processed serially
+        for( int x = 0; x < roi.cols; x += 8 )
+        {
+            Mat part;
+            reduce(roi.colRange(x, std::min(x + 8, roi.cols)), part, 0, ops[k], CV_64F);
+            EXPECT_EQ(0, cvtest::norm(part, rows.colRange(x, x + part.cols), NORM_INF));
+        }
+        for( int y = 0; y < roi.rows; y += 8 )
+        {
+            Mat part;
+            reduce(roi.rowRange(y, std::min(y + 8, roi.rows)), part, 1, ops[k], CV_64F);
+            EXPECT_EQ(0, cvtest::norm(part, cols.rowRange(y, y + part.rows), NORM_INF));
+        }
+    }
+}
+
 
 TEST(Core_IOArray, submat_assignment)
 {
@@ -2726,6 +2726,71 @@ TEST(Core_SVD, flt)
     EXPECT_LE(cvtest::norm(B1, B, NORM_L2 + NORM_RELATIVE), FLT_EPSILON*10);
 }
 
+TEST(Core_SVD, householder_qr_vs_jacobi)
+{
+    // the two diagonal blocks are small enough to be decomposed with the Jacobi method,
+    // the whole matrix goes through the bidiagonalization
+    RNG& rng = theRNG();
+    for( int type = CV_32F; type <= CV_64F; type++ )
+        for( int iter = 0; iter < 5; iter++ )
+        {
+            int m0 = rng.uniform(16, 32), n0 = rng.uniform(16, 32);
+            int m1 = rng.uniform(16, 32), n1 = rng.uniform(16, 32);
+            Mat a0(m0, n0, type), a1(m1, n1, type), a = Mat::zeros(m0 + m1, n0 + n1, type);
+            rng.fill(a0, RNG::UNIFORM, -1, 1);
+            rng.fill(a1, RNG::UNIFORM, -1, 1);
+            a0.copyTo(a(Rect(0, 0, n0, m0)));
+            a1.copyTo(a(Rect(n0, m0, n1, m1)));
+
+            Mat w0, w1, w, wref;
+            SVD::compute(a0, w0, SVD::NO_UV);
+            SVD::compute(a1, w1, SVD::NO_UV);
+            vconcat(w0, w1, wref);
+            cv::sort(wref, wref, SORT_EVERY_COLUMN + SORT_DESCENDING);
+            wref.resize(std::min(a.rows, a.cols), Scalar::all(0));
+            SVD::compute(a, w, SVD::NO_UV);
+
+            double eps = type == CV_32F ? 1e-5 : 1e-12;
+            ASSERT_LE(cvtest::norm(w, wref, NORM_INF), eps*norm(wref, NORM_INF)) << "size " << a.size();
+        }
+}
+
+TEST(Core_SVD, householder_qr_decomposition)
+{
+    const Size sizes[] = { Size(64, 64), Size(70, 150), Size(150, 70), Size(200, 200) };
+    RNG& rng = theRNG();
+    for( int type = CV_32F; type <= CV_64F; type++ )
+        for( size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++ )
+            for( int full_uv = 0; full_uv < 2; full_uv++ )
+            {
+                Mat a(sizes[i], type), w, u, vt;
+                rng.fill(a, RNG::UNIFORM, -1, 1);
+                if( i == 3 )
+                {
+                    // rank deficient
+                    a.row(3).copyTo(a.row(10));
+                    a.col(5).copyTo(a.col(7));
+                    a.row(20) = Scalar::all(0);
+                }
+                SVD::compute(a, w, u, vt, full_uv ? SVD::FULL_UV : 0);
+
+                int r = std::min(a.rows, a.cols);
+                double eps = type == CV_32F ? 1e-5 : 1e-12;
+                ASSERT_EQ(full_uv ? a.rows : r, u.cols);
+                ASSERT_EQ(full_uv ? a.cols : r, vt.rows);
+                Mat w64;
+                w.convertTo(w64, CV_64F);
+                for( int k = 1; k < r; k++ )
+                    ASSERT_GE(w64.at<double>(k - 1), w64.at<double>(k));
+                ASSERT_GE(w64.at<double>(r - 1), 0);
+
+                Mat a1 = u.colRange(0, r)*Mat::diag(w)*vt.rowRange(0, r);
+                EXPECT_LE(cvtest::norm(a1, a, NORM_INF), eps*r) << "size " << a.size();
+                EXPECT_LE(cvtest::norm(u.t()*u, Mat::eye(u.cols, u.cols, type), NORM_INF), eps*r);
+                EXPECT_LE(cvtest::norm(vt*vt.t(), Mat::eye(vt.rows, vt.rows, type), NORM_INF), eps*r);
+            }
+}
+
 
 // TODO: eigenvv, invsqrt, cbrt, fastarctan, (round, floor, ceil(?)),
 
@@ -2858,6 +2923,93 @@ TEST_P(Core_KMeans_InputVariants, singular)
 
 INSTANTIATE_TEST_CASE_P(AllVariants, Core_KMeans_InputVariants, KMeansInputVariant::all());
 
+static Mat makeKMeansBlobs(RNG& rng, int N, int dims, int nblobs, double spread, Mat* blob_labels = 0)
+{
+    Mat blob_centers(nblobs, dims, CV_32F), data(N, dims, CV_32F), noise(1, dims, CV_32F);
+    rng.fill(blob_centers, RNG::UNIFORM, -spread, spread);
+    if( blob_labels )
+        blob_labels->create(N, 1, CV_32S);
+    for( int i = 0; i < N; i++ )
+    {
+        int b = rng.uniform(0, nblobs);
+        rng.fill(noise, RNG::NORMAL, 0, 1);
+        add(blob_centers.row(b), noise, data.row(i));
+        if( blob_labels )
+            blob_labels->at<int>(i) = b;
+    }
+    return data;
+}
+
+TEST(Core_KMeans, bounds_match_full_search)
+{
+    const int dims_list[] = { 2, 16, 100 };
+    const int K_list[] = { 1, 7, 40 };
+    RNG& rng = theRNG();
+    for( int d = 0; d < 3; d++ )
+        for( int k = 0; k < 3; k++ )
+            for( int pp = 0; pp < 2; pp++ )
+            {
+                int dims = dims_list[d], K = K_list[k];
+                Mat data = makeKMeansBlobs(rng, 2000, dims, 10, 5);
+                int flags = pp ? KMEANS_PP_CENTERS : KMEANS_RANDOM_CENTERS;
+                TermCriteria crit(TermCriteria::MAX_ITER+TermCriteria::EPS, 50, 0);
+                Mat labels0, labels1, centers0, centers1;
+                uint64 state = rng.state;
+
+                theRNG().state = state;
+                double c0 = kmeans(data, K, labels0, crit, 2, flags, centers0);
+                theRNG().state = state;
+                double c1 = kmeans(data, K, labels1, crit, 2, flags | KMEANS_USE_BOUNDS, centers1);
+
+                ASSERT_EQ(0, cvtest::norm(labels0, labels1, NORM_INF)) << "dims=" << dims << ", K=" << K;
+                ASSERT_EQ(0, cvtest::norm(centers0, centers1, NORM_INF)) << "dims=" << dims << ", K=" << K;
+                ASSERT_EQ(c0, c1);
+            }
+}
+
+TEST(Core_KMeans, parallel_centers)
+{
+    const int K = 12;
+    RNG& rng = theRNG();
+    for( int iter = 0; iter < 10; iter++ )
+    {
+        Mat blob_labels, labels, centers;
+        Mat data = makeKMeansBlobs(rng, 3000, 3, K, 1000, &blob_labels);
+        kmeans(data, K, labels, TermCriteria(TermCriteria::MAX_ITER+TermCriteria::EPS, 30, 0),
+               1, KMEANS_PARALLEL_CENTERS, centers);
+
+        // every blob has to end up in a cluster of its own
+        std::vector<int> blob_to_label(K, -1), label_to_blob(K, -1);
+        for( int i = 0; i < data.rows; i++ )
+        {
+            int b = blob_labels.at<int>(i), l = labels.at<int>(i);
+            if( blob_to_label[b] < 0 )
+                blob_to_label[b] = l;
+            if( label_to_blob[l] < 0 )
+                label_to_blob[l] = b;
+            ASSERT_EQ(blob_to_label[b], l);
+            ASSERT_EQ(label_to_blob[l], b);
+        }
+    }
+}
+
+TEST(Core_KMeans, mini_batch)
+{
+    const int K = 8;
+    RNG& rng = theRNG();
+    for( int iter = 0; iter < 5; iter++ )
+    {
+        Mat labels0, labels1, centers;
+        Mat data = makeKMeansBlobs(rng, 20000, 8, K, 1000);
+        TermCriteria crit(TermCriteria::MAX_ITER+TermCriteria::EPS, 30, 0);
+        double c0 = kmeans(data, K, labels0, crit, 3, KMEANS_PP_CENTERS);
+        double c1 = kmeans(data, K, labels1, crit, 3, KMEANS_PP_CENTERS | KMEANS_MINI_BATCH, centers);
+
+        ASSERT_EQ(K, centers.rows);
+        ASSERT_LE(c1, c0*1.05);
+    }
+}
+
 TEST(CovariationMatrixVectorOfMat, accuracy)
 {
     unsigned int col_problem_size = 8, row_problem_size = 8, vector_size = 16;
@@ -2924,6 +3076,50 @@ TEST(CovariationMatrixVectorOfMatWithMean, accuracy)
     ASSERT_EQ(sDiff.dot(sDiff), 0.0);
 }
 
+TEST(Core_GEMM, packed_32f)
+{
+    RNG& rng = theRNG();
+    for( int iter = 0; iter < 60; iter++ )
+    {
+        int flags = iter & (GEMM_1_T|GEMM_2_T|GEMM_3_T);
+        int m = rng.uniform(1, 200), n = rng.uniform(1, 300), k = rng.uniform(1, 600);
+        bool useC = (iter & 8) == 0;
+        double alpha = rng.uniform(-2., 2.), beta = useC ? rng.uniform(-2., 2.) : 0.;
+
+        // ROIs of larger matrices, so the strides differ from the widths
+        Mat A0((flags & GEMM_1_T ? k : m) + 3, (flags & GEMM_1_T ? m : k) + 5, CV_32F);
+        Mat B0((flags & GEMM_2_T ? n : k) + 2, (flags & GEMM_2_T ? k : n) + 7, CV_32F);
+        Mat C0((flags & GEMM_3_T ? n : m) + 1, (flags & GEMM_3_T ? m : n) + 4, CV_32F);
+        randu(A0, -1, 1); randu(B0, -1, 1); randu(C0, -1, 1);
+        Mat A = A0(Rect(2, 1, A0.cols - 5, A0.rows - 3));
+        Mat B = B0(Rect(3, 2, B0.cols - 7, B0.rows - 2));
+        Mat C = C0(Rect(1, 1, C0.cols - 4, C0.rows - 1));
+
+        Mat A64, B64, C64, D64, Dref, D;
+        A.convertTo(A64, CV_64F); B.convertTo(B64, CV_64F); C.convertTo(C64, CV_64F);
+        gemm(A64, B64, alpha, useC ? C64 : Mat(), beta, D64, flags);
+        D64.convertTo(Dref, CV_32F);
+
+        gemm(A, B, alpha, useC ? C : Mat(), beta, D, flags);
+        double err = cvtest::norm(D, Dref, NORM_INF | NORM_RELATIVE);
+        ASSERT_LT(err, 1e-5) << "m=" << m << " n=" << n << " k=" << k << " flags=" << flags;
+
+        // in-place accumulation into C, and an output that aliases A
+        if( useC && !(flags & GEMM_3_T) )
+        {
+            Mat Cd = C.clone();
+            gemm(A, B, alpha, Cd, beta, Cd, flags);
+            ASSERT_LT(cvtest::norm(Cd, Dref, NORM_INF | NORM_RELATIVE), 1e-5);
+        }
+        if( !(flags & GEMM_1_T) && k == n )
+        {
+            Mat Ad = A.clone();
+            gemm(Ad, B, alpha, useC ? C : Mat(), beta, Ad, flags);
+            ASSERT_LT(cvtest::norm(Ad, Dref, NORM_INF | NORM_RELATIVE), 1e-5);
+        }
+    }
+}
+
 TEST(Core_Pow, special)
 {
     for( int i = 0; i < 100; i++ )